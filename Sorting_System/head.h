@@ -1,6 +1,7 @@
 #ifndef HEAD_H
 #define HEAD_H
 
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +10,25 @@
 
 // 1. ݽṹ
 
+// Ӳܼ (valid Ϊ HW_* λ룬δλ)
+// Windows û̬ PMUֻȡ߳Ҫںʼղ
+#define HW_CYCLES        0x1
+#define HW_INSTRUCTIONS  0x2
+#define HW_BRANCH_MISSES 0x4
+#define HW_L1D_MISSES    0x8
+#define HW_LLC_MISSES    0x10
+#define HW_DTLB_MISSES   0x20
+
+typedef struct {
+    int valid;
+    long long cycles;
+    long long instructions;
+    long long branchMisses;
+    long long l1dMisses;
+    long long llcMisses;
+    long long dtlbMisses;
+} HwCounters;
+
 // ͳƽṹ
 typedef struct SortPerformance {
     char algorithm[20];   // 㷨
@@ -16,6 +36,8 @@ typedef struct SortPerformance {
     long compareCount;    // Ƚϴ
     long moveCount;       // ƶ
     double timeCost;      // ִкʱ ()
+    int passes;           // ִе㷨 () 
+    HwCounters hw;        // Ӳ
 } SortPerformance;
 
 // ǵݹõջڵ
@@ -35,24 +57,49 @@ typedef struct {
 
 extern long g_compareCount;
 extern long g_moveCount;
+extern int g_passCount;
 extern int g_visualize;          // ӻ
-extern int g_delay;             // ʱ(ms)
+extern int g_fps;               // ӻˢ (֡/)
 extern LARGE_INTEGER g_cpuFreq;      // CPUʱƵ
 
+// ׮꣺㷨ڲѭֻͨЩ/ˢʾ
+// ʱ SORT_NO_INSTRUMENT õӻ㿪汾
+#ifdef SORT_NO_INSTRUMENT
+#define COUNT_CMP()       ((void)0)
+#define COUNT_MOVE(k)     ((void)0)
+#define COUNT_PASS()      ((void)0)
+#define VISUALIZE(arr, n) ((void)0)
+#else
+#define COUNT_CMP()       (g_compareCount++)
+#define COUNT_MOVE(k)     (g_moveCount += (k))
+#define COUNT_PASS()      (g_passCount++)
+#define VISUALIZE(arr, n) visualize(arr, n)
+#endif
+
 // 3. 
 
 // ջ
 void initStack(SeqStack* s, int capacity);
 int isStackEmpty(SeqStack* s);
-void push(SeqStack* s, int low, int high);
+int push(SeqStack* s, int low, int high);   // ջ 0
 void pop(SeqStack* s, int* low, int* high);
 void freeStack(SeqStack* s);
 
+// ɸùλĻֻظʱٷ
+#define WS_DATA 0     // testAlgorithm ݸ
+#define WS_TEMP 1     // 鲢/ʱ
+#define WS_SLOTS 2
+int* workspaceGet(int slot, int n);
+void workspaceFree(void);
+
 // 
 void initTimer();
 long long getTick();
 double calcDuration(long long start, long long end);
-void visualize(int arr[], int n);
+void formatCounter(char* buf, size_t size, const HwCounters* hw, int bit, long long value);
+void visualizeBegin(int arr[], int n);   // ӻʱȾ߳
+void visualize(int arr[], int n);        // գ
+void visualizeEnd(int arr[], int n);     // ֹͣȾ̲߳״̬
 void swap(int* a, int* b);
 void copyArray(int src[], int dest[], int n);
 int min_val(int x, int y);
@@ -75,6 +122,9 @@ void MergeSort(int arr[], int n);
 int Partition(int arr[], int low, int high, int n_visual);
 void QuickSortIterative(int arr[], int n);
 
+// 
+void RadixSort(int arr[], int n);
+
 // ݹIOģ
 void generateData(int arr[], int n, int type);
 void printArray(int arr[], int n);
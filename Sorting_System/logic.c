@@ -13,12 +13,12 @@ int isStackEmpty(SeqStack* s) {
     return s->top == -1;
 }
 
-void push(SeqStack* s, int low, int high) {
-    if (s->top < s->capacity - 1) {
-        s->top++;
-        s->data[s->top].low = low;
-        s->data[s->top].high = high;
-    }
+int push(SeqStack* s, int low, int high) {
+    if (s->top >= s->capacity - 1) return 0;
+    s->top++;
+    s->data[s->top].low = low;
+    s->data[s->top].high = high;
+    return 1;
 }
 
 void pop(SeqStack* s, int* low, int* high) {
@@ -36,6 +36,29 @@ void freeStack(SeqStack* s) {
     }
 }
 
+// ɸù64 ֽڶ룬ʱҳһ飬ȱҳʱ
+#define WS_PAGE_INTS 1024    // 4KB ҳ int 
+
+static int* g_ws[WS_SLOTS];
+static int g_wsCap[WS_SLOTS];
+
+int* workspaceGet(int slot, int n) {
+    if (n <= g_wsCap[slot]) return g_ws[slot];
+    _aligned_free(g_ws[slot]);
+    g_ws[slot] = (int*)_aligned_malloc((size_t)n * sizeof(int), 64);
+    g_wsCap[slot] = g_ws[slot] ? n : 0;
+    for (int i = 0; i < g_wsCap[slot]; i += WS_PAGE_INTS) g_ws[slot][i] = 0;
+    return g_ws[slot];
+}
+
+void workspaceFree(void) {
+    for (int i = 0; i < WS_SLOTS; i++) {
+        _aligned_free(g_ws[i]);
+        g_ws[i] = NULL;
+        g_wsCap[i] = 0;
+    }
+}
+
 // 3. 
 
 // ʼ߾ȼʱ
@@ -55,26 +78,184 @@ double calcDuration(long long start, long long end) {
     return (double)(end - start) / g_cpuFreq.QuadPart;
 }
 
-// ӻչʾ 
-void visualize(int arr[], int n) {
-    if (!g_visualize) return;
-    system("cls");
-    printf("--- ӻ ---\n");
-    for (int i = 0; i < n; i++) {
-        printf("%3d | ", arr[i]);
-        // ״ͼ
-        if (n <= 30) {
-            for (int k = 0; k < arr[i]; k++) printf("*");
-        }
-        printf("\n");
+// ӲһʱΪ "n/a"
+void formatCounter(char* buf, size_t size, const HwCounters* hw, int bit, long long value) {
+    if (hw->valid & bit) sprintf_s(buf, size, "%lld", value);
+    else sprintf_s(buf, size, "n/a");
+}
+
+// ӻֻ߳գƽȾ̡߳
+// Ⱦ̰߳֡ʽİ request  1߳һε visualize ʱŸ鲢֪ͨ
+// ֻۼӲأӲȴʾ
+//  ANSI 궨λֻػֵ仯У֡ƴһһд
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#define VIS_LABEL_WIDTH 9    //  "%6d | " Ŀ
+
+typedef struct {
+    int* snap;               // ̷߳Ŀ
+    int capacity;
+    int snapN;
+    volatile LONG request;   // Ⱦ߳Ҫ֡ʱ 1̸߳ǰ 0
+    volatile LONG stop;
+    volatile long long steps; // visualize ĵô
+    HANDLE frameReady;       // д (Ҫ˳)
+    HANDLE thread;
+    HANDLE out;
+    int vt;                  // ̨֧ ANSI ת
+    int rows, cols;
+    int maxValue;
+    int* shown;              // еǰʾֵ
+    int frames;
+    char* buf;               // Ԥȷ֡
+    char* bufEnd;
+} Visualizer;
+
+static Visualizer g_vis;
+
+static char* visPrintf(char* p, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsprintf_s(p, (size_t)(g_vis.bufEnd - p), fmt, ap);
+    va_end(ap);
+    return len > 0 ? p + len : p;
+}
+
+// ԪʱÿдһΣʾֵ
+static int visRowValue(const int* a, int n, int r) {
+    int lo = (int)((long long)r * n / g_vis.rows);
+    int hi = (int)((long long)(r + 1) * n / g_vis.rows);
+    int v = a[lo];
+    for (int i = lo + 1; i < hi; i++) if (a[i] > v) v = a[i];
+    return v;
+}
+
+// full Ϊ 1 ʱػ
+static void visRender(const int* a, int n, int full) {
+    char* p = g_vis.buf;
+    int barWidth = g_vis.cols - VIS_LABEL_WIDTH - 1;
+    if (!g_vis.vt) {
+        COORD home = { 0, 0 };
+        SetConsoleCursorPosition(g_vis.out, home);
+        full = 1;
     }
-    Sleep(g_delay);
+    else {
+        p = visPrintf(p, "\x1b[1;1H");
+    }
+    char* line = p;
+    p = visPrintf(p, "--- ӻ --- ֡ %d   %lld  Ƚ %ld  ƶ %ld",
+        ++g_vis.frames, g_vis.steps, g_compareCount, g_moveCount);
+    if (g_vis.vt) p = visPrintf(p, "\x1b[K");
+    else { while (p - line < g_vis.cols - 1) *p++ = ' '; *p++ = '\n'; }
+
+    for (int r = 0; r < g_vis.rows; r++) {
+        int v = visRowValue(a, n, r);
+        if (!full && v == g_vis.shown[r]) continue;
+        g_vis.shown[r] = v;
+        if (g_vis.vt) p = visPrintf(p, "\x1b[%d;1H", r + 2);
+        line = p;
+        p = visPrintf(p, "%6d | ", v);
+        int len = v <= 0 ? 0 : (int)((long long)v * barWidth / g_vis.maxValue);
+        if (len > barWidth) len = barWidth;
+        memset(p, '*', len);
+        p += len;
+        if (g_vis.vt) p = visPrintf(p, "\x1b[K");
+        else { while (p - line < g_vis.cols - 1) *p++ = ' '; *p++ = '\n'; }
+    }
+    if (g_vis.vt) p = visPrintf(p, "\x1b[%d;1H", g_vis.rows + 2);
+
+    DWORD written;
+    WriteFile(g_vis.out, g_vis.buf, (DWORD)(p - g_vis.buf), &written, NULL);
+}
+
+static DWORD WINAPI visThread(LPVOID param) {
+    (void)param;
+    DWORD interval = 1000 / (g_fps > 0 ? g_fps : 30);
+    while (!g_vis.stop) {
+        DWORD start = GetTickCount();
+        InterlockedExchange(&g_vis.request, 1);
+        WaitForSingleObject(g_vis.frameReady, INFINITE);
+        if (g_vis.stop) break;
+        visRender(g_vis.snap, g_vis.snapN, 0);
+        DWORD spent = GetTickCount() - start;
+        if (spent < interval) Sleep(interval - spent);
+    }
+    return 0;
+}
+
+static void visFree() {
+    free(g_vis.snap);
+    free(g_vis.shown);
+    free(g_vis.buf);
+    if (g_vis.frameReady) CloseHandle(g_vis.frameReady);
+    memset(&g_vis, 0, sizeof(g_vis));
+}
+
+void visualizeBegin(int arr[], int n) {
+    if (!g_visualize || n <= 0) return;
+    memset(&g_vis, 0, sizeof(g_vis));
+    g_vis.out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode;
+    g_vis.vt = GetConsoleMode(g_vis.out, &mode) && SetConsoleMode(g_vis.out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    int winRows = 25;
+    g_vis.cols = 80;
+    if (GetConsoleScreenBufferInfo(g_vis.out, &info)) {
+        winRows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        g_vis.cols = info.srWindow.Right - info.srWindow.Left + 1;
+    }
+    if (g_vis.cols < VIS_LABEL_WIDTH + 2) g_vis.cols = VIS_LABEL_WIDTH + 2;
+    g_vis.rows = winRows - 3 < n ? winRows - 3 : n;
+    if (g_vis.rows < 1) g_vis.rows = 1;
+    g_vis.maxValue = 1;
+    for (int i = 0; i < n; i++) if (arr[i] > g_vis.maxValue) g_vis.maxValue = arr[i];
+
+    g_vis.capacity = n;
+    g_vis.snap = (int*)malloc(n * sizeof(int));
+    g_vis.shown = (int*)malloc(g_vis.rows * sizeof(int));
+    size_t bufSize = (size_t)(g_vis.rows + 2) * (g_vis.cols + 32) + 256;
+    g_vis.buf = (char*)malloc(bufSize);
+    g_vis.bufEnd = g_vis.buf + bufSize;
+    g_vis.frameReady = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!g_vis.snap || !g_vis.shown || !g_vis.buf || !g_vis.frameReady) { visFree(); return; }
+
+    // һΣֻ֮
+    if (g_vis.vt) {
+        DWORD written;
+        WriteFile(g_vis.out, "\x1b[2J", 4, &written, NULL);
+    }
+    visRender(arr, n, 1);
+    g_vis.thread = CreateThread(NULL, 0, visThread, NULL, 0, NULL);
+    if (!g_vis.thread) visFree();
+}
+
+void visualize(int arr[], int n) {
+    if (!g_vis.thread) return;
+    g_vis.steps++;
+    if (!g_vis.request) return;
+    if (InterlockedCompareExchange(&g_vis.request, 0, 1) != 1) return;
+    if (n > g_vis.capacity) n = g_vis.capacity;
+    memcpy(g_vis.snap, arr, n * sizeof(int));
+    g_vis.snapN = n;
+    SetEvent(g_vis.frameReady);
+}
+
+void visualizeEnd(int arr[], int n) {
+    if (!g_vis.thread) return;
+    InterlockedExchange(&g_vis.stop, 1);
+    SetEvent(g_vis.frameReady);
+    WaitForSingleObject(g_vis.thread, INFINITE);
+    CloseHandle(g_vis.thread);
+    visRender(arr, n, 0);    // ״̬
+    visFree();
 }
 
 // Ԫ
 void swap(int* a, int* b) {
     int temp = *a; *a = *b; *b = temp;
-    g_moveCount += 3; // Ϊ3ƶ 
+    COUNT_MOVE(3); // Ϊ3ƶ 
 }
 
 // 鿽
@@ -93,10 +274,10 @@ int min_val(int x, int y) {
 void BubbleSort(int arr[], int n) {
     for (int i = 0; i < n - 1; i++) {
         for (int j = 0; j < n - 1 - i; j++) {
-            g_compareCount++;
+            COUNT_CMP();
             if (arr[j] > arr[j + 1]) {
                 swap(&arr[j], &arr[j + 1]);
-                visualize(arr, n);
+                VISUALIZE(arr, n);
             }
         }
     }
@@ -106,16 +287,16 @@ void BubbleSort(int arr[], int n) {
 void InsertSort(int arr[], int n) {
     int i, j, temp;
     for (i = 1; i < n; i++) {
-        temp = arr[i]; g_moveCount++;
-        j = i - 1; g_compareCount++;
+        temp = arr[i]; COUNT_MOVE(1);
+        j = i - 1; COUNT_CMP();
         while (j >= 0 && arr[j] > temp) {
-            g_compareCount++;
-            arr[j + 1] = arr[j]; g_moveCount++;
+            COUNT_CMP();
+            arr[j + 1] = arr[j]; COUNT_MOVE(1);
             j--;
-            visualize(arr, n);
+            VISUALIZE(arr, n);
         }
-        arr[j + 1] = temp; g_moveCount++;
-        visualize(arr, n);
+        arr[j + 1] = temp; COUNT_MOVE(1);
+        VISUALIZE(arr, n);
     }
 }
 
@@ -124,12 +305,12 @@ void SelectSort(int arr[], int n) {
     for (int i = 0; i < n - 1; i++) {
         int minIdx = i;
         for (int j = i + 1; j < n; j++) {
-            g_compareCount++;
+            COUNT_CMP();
             if (arr[j] < arr[minIdx]) minIdx = j;
         }
         if (minIdx != i) {
             swap(&arr[i], &arr[minIdx]);
-            visualize(arr, n);
+            VISUALIZE(arr, n);
         }
     }
 }
@@ -139,34 +320,34 @@ void ShellSort(int arr[], int n) {
     int gap, i, j, temp;
     for (gap = n / 2; gap > 0; gap /= 2) {
         for (i = gap; i < n; i++) {
-            temp = arr[i]; g_moveCount++;
-            j = i; g_compareCount++;
+            temp = arr[i]; COUNT_MOVE(1);
+            j = i; COUNT_CMP();
             while (j >= gap && arr[j - gap] > temp) {
-                g_compareCount++;
-                arr[j] = arr[j - gap]; g_moveCount++;
+                COUNT_CMP();
+                arr[j] = arr[j - gap]; COUNT_MOVE(1);
                 j -= gap;
-                visualize(arr, n);
+                VISUALIZE(arr, n);
             }
-            arr[j] = temp; g_moveCount++;
+            arr[j] = temp; COUNT_MOVE(1);
         }
     }
 }
 
 // 4.5 
 void HeapAdjustIterative(int arr[], int n, int i) {
-    int temp = arr[i]; g_moveCount++;
+    int temp = arr[i]; COUNT_MOVE(1);
     int k = 2 * i + 1; // 
 
     while (k < n) {
-        g_compareCount++;
+        COUNT_CMP();
         // ĺ
         if (k + 1 < n && arr[k] < arr[k + 1]) {
             k++;
         }
 
-        g_compareCount++;
+        COUNT_CMP();
         if (arr[k] > temp) {
-            arr[i] = arr[k]; g_moveCount++;
+            arr[i] = arr[k]; COUNT_MOVE(1);
             i = k; // Ѱλ
             k = 2 * i + 1;
         }
@@ -174,21 +355,21 @@ void HeapAdjustIterative(int arr[], int n, int i) {
             break;
         }
     }
-    arr[i] = temp; g_moveCount++;
+    arr[i] = temp; COUNT_MOVE(1);
 }
 
 void HeapSort(int arr[], int n) {
     // 1. 
     for (int i = n / 2 - 1; i >= 0; i--) {
         HeapAdjustIterative(arr, n, i);
-        visualize(arr, n);
+        VISUALIZE(arr, n);
     }
     // 2. 
     for (int i = n - 1; i > 0; i--) {
         swap(&arr[0], &arr[i]);
-        visualize(arr, n);
+        VISUALIZE(arr, n);
         HeapAdjustIterative(arr, i, 0);
-        visualize(arr, n);
+        VISUALIZE(arr, n);
     }
 }
 
@@ -196,19 +377,19 @@ void HeapSort(int arr[], int n) {
 void Merge(int arr[], int l, int m, int r, int temp[]) {
     int i = l, j = m + 1, k = l;
     while (i <= m && j <= r) {
-        g_compareCount++;
-        if (arr[i] <= arr[j]) { temp[k++] = arr[i++]; g_moveCount++; }
-        else { temp[k++] = arr[j++]; g_moveCount++; }
+        COUNT_CMP();
+        if (arr[i] <= arr[j]) { temp[k++] = arr[i++]; COUNT_MOVE(1); }
+        else { temp[k++] = arr[j++]; COUNT_MOVE(1); }
     }
-    while (i <= m) { temp[k++] = arr[i++]; g_moveCount++; }
-    while (j <= r) { temp[k++] = arr[j++]; g_moveCount++; }
+    while (i <= m) { temp[k++] = arr[i++]; COUNT_MOVE(1); }
+    while (j <= r) { temp[k++] = arr[j++]; COUNT_MOVE(1); }
 
     // ԭ
-    for (i = l; i <= r; i++) { arr[i] = temp[i]; g_moveCount++; }
+    for (i = l; i <= r; i++) { arr[i] = temp[i]; COUNT_MOVE(1); }
 }
 
 void MergeSort(int arr[], int n) {
-    int* temp = (int*)malloc(n * sizeof(int));
+    int* temp = workspaceGet(WS_TEMP, n);
     if (!temp) return;
 
     // curr_size: ǰϲеĴС 1 -> 2 -> 4 -> 8...
@@ -219,31 +400,34 @@ void MergeSort(int arr[], int n) {
             int right_end = min_val(left_start + 2 * curr_size - 1, n - 1);
 
             Merge(arr, left_start, mid, right_end, temp);
-            visualize(arr, n);
+            VISUALIZE(arr, n);
         }
     }
-    free(temp);
 }
 
 // 4.7 
 int Partition(int arr[], int low, int high, int n_visual) {
-    int pivot = arr[low]; g_moveCount++;
+    int pivot = arr[low]; COUNT_MOVE(1);
     while (low < high) {
-        while (low < high && arr[high] >= pivot) { g_compareCount++; high--; }
-        g_compareCount++; arr[low] = arr[high]; g_moveCount++;
-        while (low < high && arr[low] <= pivot) { g_compareCount++; low++; }
-        g_compareCount++; arr[high] = arr[low]; g_moveCount++;
-        visualize(arr, n_visual);
+        while (low < high && arr[high] >= pivot) { COUNT_CMP(); high--; }
+        COUNT_CMP(); arr[low] = arr[high]; COUNT_MOVE(1);
+        while (low < high && arr[low] <= pivot) { COUNT_CMP(); low++; }
+        COUNT_CMP(); arr[high] = arr[low]; COUNT_MOVE(1);
+        VISUALIZE(arr, n_visual);
     }
-    arr[low] = pivot; g_moveCount++;
+    arr[low] = pivot; COUNT_MOVE(1);
     return low;
 }
 
+#define QS_STACK_DEPTH 64   // ջȲ log2(n) + 1int Χ 64 㹻
+
 void QuickSortIterative(int arr[], int n) {
     if (n <= 1) return;
 
-    SeqStack stack;
-    initStack(&stack, n); // ʼջ
+    // ѹϴһ࣬Сһ漴ջȴջÿһټ룬
+    // ù̶Сľֲ鼴ɣذ n 
+    StackNode nodes[QS_STACK_DEPTH];
+    SeqStack stack = { nodes, -1, QS_STACK_DEPTH };
     push(&stack, 0, n - 1); // ѹʼ
 
     int low, high, pivot;
@@ -253,29 +437,68 @@ void QuickSortIterative(int arr[], int n) {
 
         pivot = Partition(arr, low, high, n);
 
-        // ұԪأѹջ
-        if (pivot + 1 < high) {
-            push(&stack, pivot + 1, high);
+        if (pivot - low > high - pivot) {
+            if (low < pivot - 1) push(&stack, low, pivot - 1);
+            if (pivot + 1 < high) push(&stack, pivot + 1, high);
         }
-        // Ԫأѹջ
-        if (low < pivot - 1) {
-            push(&stack, low, pivot - 1);
+        else {
+            if (pivot + 1 < high) push(&stack, pivot + 1, high);
+            if (low < pivot - 1) push(&stack, low, pivot - 1);
+        }
+    }
+}
+
+// 4.8  (LSDֽڷ 4 )
+// һɨͳ 4 ˵ֱͼֽڷתλʹǰ棻
+// ĳԪͬͰʱ
+void RadixSort(int arr[], int n) {
+    if (n <= 1) return;
+    int* temp = workspaceGet(WS_TEMP, n);
+    if (!temp) return;
+    int hist[4 * 256] = { 0 };
+
+    for (int i = 0; i < n; i++) {
+        unsigned u = (unsigned)arr[i] ^ 0x80000000u;
+        for (int p = 0; p < 4; p++) hist[p * 256 + ((u >> (8 * p)) & 0xFF)]++;
+    }
+
+    int* src = arr;
+    int* dst = temp;
+    unsigned first = (unsigned)arr[0] ^ 0x80000000u;
+    for (int p = 0; p < 4; p++) {
+        int* h = hist + p * 256;
+        if (h[(first >> (8 * p)) & 0xFF] == n) continue;
+
+        int offset[256], sum = 0;
+        for (int b = 0; b < 256; b++) { offset[b] = sum; sum += h[b]; }
+        for (int i = 0; i < n; i++) {
+            unsigned u = (unsigned)src[i] ^ 0x80000000u;
+            dst[offset[(u >> (8 * p)) & 0xFF]++] = src[i]; COUNT_MOVE(1);
         }
+        COUNT_PASS();
+
+        int* t = src; src = dst; dst = t;
+        VISUALIZE(src, n);
+    }
+    if (src != arr) {
+        for (int i = 0; i < n; i++) { arr[i] = src[i]; COUNT_MOVE(1); }
     }
-    freeStack(&stack);
 }
 
 // 5. ݹIOģ 
+//  main ʱһΣﲻ²
 void generateData(int arr[], int n, int type) {
-    srand((unsigned)time(NULL));
     for (int i = 0; i < n; i++) arr[i] = rand() % 100 + 1;
-    if (type == 1) { // Sorted
-        for (int i = 0; i < n - 1; i++) for (int j = 0; j < n - 1 - i; j++)
-            if (arr[j] > arr[j + 1]) { int t = arr[j]; arr[j] = arr[j + 1]; arr[j + 1] = t; }
-    }
-    else if (type == 2) { // Reverse
-        for (int i = 0; i < n - 1; i++) for (int j = 0; j < n - 1 - i; j++)
-            if (arr[j] < arr[j + 1]) { int t = arr[j]; arr[j] = arr[j + 1]; arr[j + 1] = t; }
+    if (type == 1 || type == 2) { // Sorted / Reverseȡֵֻ 1..100 O(n)
+        int cnt[101] = { 0 };
+        for (int i = 0; i < n; i++) cnt[arr[i]]++;
+        int k = 0;
+        for (int v = 1; v <= 100; v++) {
+            while (cnt[v]-- > 0) arr[k++] = v;
+        }
+        if (type == 2) {
+            for (int i = 0, j = n - 1; i < j; i++, j--) { int t = arr[i]; arr[i] = arr[j]; arr[j] = t; }
+        }
     }
 }
 
@@ -295,66 +518,78 @@ void printArray(int arr[], int n) {
     printf("--------------------\n");
 }
 
-// ޸ĺĵ뺯
+// 뺯ļڴӳ˽鰴 1.5 ٶ顣
+//  "SRTB" ͷ save_binary_file дĶ飬ֱ鸴
+#define BIN_MAGIC "SRTB"
+#define BIN_HEADER_SIZE 16   // ħ 4 + Ԫ 4 +  8
+
 int* importFromFile(int* n) {
     char filename[100];
     printf("ļ ( sort_data.txt): ");
     scanf_s("%s", filename, (unsigned)sizeof(filename));
+    *n = 0;
 
-    FILE* fp;
-    if (fopen_s(&fp, filename, "r") != 0) {
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
         printf("޷ļ %s\n", filename);
-        *n = 0;
+        return NULL;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size_t size = (size_t)fileSize.QuadPart;
+    HANDLE mapping = size ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    const char* text = mapping ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    if (!text) {
+        printf("⵽ļй 0 ݡ\n");
         return NULL;
     }
 
-    // --- һɨļݸ ---
+    int* arr = NULL;
     int count = 0;
-    int tempVal;
-    char ch;
-
-    // ѭȡԶһȻԶһַ()
-    while (fscanf_s(fp, "%d", &tempVal) == 1) {
-        count++;
-        // ȡһַǶţҲEOF
-        ch = fgetc(fp);
-        // ҲǸţֱҵһֻļ
-        while (ch != EOF && (ch < '0' || ch > '9') && ch != '-') {
-            ch = fgetc(fp);
+    if (size >= BIN_HEADER_SIZE && memcmp(text, BIN_MAGIC, 4) == 0) {
+        // ---  ---
+        unsigned long long binCount;
+        memcpy(&binCount, text + 8, sizeof(binCount));
+        if (binCount <= (size - BIN_HEADER_SIZE) / sizeof(int) && binCount <= 0x7fffffff) {
+            count = (int)binCount;
+            arr = (int*)malloc(count * sizeof(int) + 1);
+            if (arr) memcpy(arr, text + BIN_HEADER_SIZE, count * sizeof(int));
         }
-        // һַԱһ fscanf ܶ
-        if (ch != EOF) {
-            ungetc(ch, fp);
+    }
+    else {
+        // --- ıΪһ '-' ʾַǷָ ---
+        int capacity = 1024;
+        arr = (int*)malloc(capacity * sizeof(int));
+        size_t i = 0;
+        while (arr && i < size) {
+            if (text[i] < '0' || text[i] > '9') { i++; continue; }
+            int negative = i > 0 && text[i - 1] == '-';
+            unsigned value = 0;   //  int Χʱ 32 λض
+            while (i < size && text[i] >= '0' && text[i] <= '9') value = value * 10 + (unsigned)(text[i++] - '0');
+            if (count == capacity) {
+                capacity += capacity / 2;
+                int* grown = (int*)realloc(arr, capacity * sizeof(int));
+                if (!grown) { free(arr); arr = NULL; break; }
+                arr = grown;
+            }
+            arr[count++] = (int)(negative ? 0u - value : value);
         }
     }
+    UnmapViewOfFile(text);
 
+    if (!arr) {
+        printf("ڴ治ļʽЧ\n");
+        return NULL;
+    }
     *n = count;
     printf("⵽ļй %d ݡ\n", count);
-
     if (count == 0) {
-        fclose(fp);
+        free(arr);
         return NULL;
     }
-
-    // --- ڶڴ沢¶ȡ ---
-    int* arr = (int*)malloc(count * sizeof(int));
-
-    // ļָصͷ
-    rewind(fp);
-
-    for (int i = 0; i < count; i++) {
-        fscanf_s(fp, "%d", &arr[i]);
-        // ĶŻոΪȡһ׼
-        ch = fgetc(fp);
-        while (ch != EOF && (ch < '0' || ch > '9') && ch != '-') {
-            ch = fgetc(fp);
-        }
-        if (ch != EOF) {
-            ungetc(ch, fp);
-        }
-    }
-
-    fclose(fp);
     printf("ɹݡ\n");
     return arr;
 }
@@ -370,6 +605,9 @@ const char* getDistName(int type) {
 void saveResultsToFile(SortPerformance results[], int count, int type) {
     FILE* fp;
     char filename[] = "sort_report.csv";
+    char oldname[] = "sort_report.old.csv";
+    const char* header = "BatchTime,DataType,Algorithm,DataSize,Comparisons,Moves,Time(s),"
+        "Cycles,Instructions,IPC,BranchMisses,L1DMisses,LLCMisses,DTLBMisses\n";
 
     // ȡǰϵͳʱ
     time_t rawtime;
@@ -379,6 +617,21 @@ void saveResultsToFile(SortPerformance results[], int count, int type) {
     localtime_s(&timeinfo, &rawtime);
     strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
 
+    // ɰ汾д 7 б뵱ǰͷһ£Ϊ sort_report.old.csvļ
+    if (fopen_s(&fp, filename, "r") == 0) {
+        char line[256];
+        int stale = fgets(line, sizeof(line), fp) != NULL && strcmp(line, header) != 0;
+        fclose(fp);
+        if (stale) {
+            remove(oldname);
+            if (rename(filename, oldname) != 0) {
+                printf("%s Ϊɸʽ޷\n", filename);
+                return;
+            }
+            printf("ɸʽѸΪ %s\n", oldname);
+        }
+    }
+
     // ׷ģʽ
     if (fopen_s(&fp, filename, "a") != 0) {
         printf("޷дļ\n");
@@ -388,19 +641,32 @@ void saveResultsToFile(SortPerformance results[], int count, int type) {
     // ļΪգдͷ
     fseek(fp, 0, SEEK_END);
     if (ftell(fp) == 0) {
-        fprintf(fp, "BatchTime,DataType,Algorithm,DataSize,Comparisons,Moves,Time(s)\n");
+        fputs(header, fp);
     }
 
-    // д
+    // д (õӲ)
     for (int i = 0; i < count; i++) {
-        fprintf(fp, "%s,%s,%s,%d,%ld,%ld,%.8f\n",
+        const HwCounters* hw = &results[i].hw;
+        char f[7][24];
+        long long value[6] = { hw->cycles, hw->instructions, hw->branchMisses, hw->l1dMisses, hw->llcMisses, hw->dtlbMisses };
+        int bit[6] = { HW_CYCLES, HW_INSTRUCTIONS, HW_BRANCH_MISSES, HW_L1D_MISSES, HW_LLC_MISSES, HW_DTLB_MISSES };
+        for (int k = 0; k < 6; k++) {
+            if (hw->valid & bit[k]) sprintf_s(f[k < 2 ? k : k + 1], sizeof(f[0]), "%lld", value[k]);
+            else f[k < 2 ? k : k + 1][0] = '\0';
+        }
+        if ((hw->valid & (HW_CYCLES | HW_INSTRUCTIONS)) == (HW_CYCLES | HW_INSTRUCTIONS) && hw->cycles > 0)
+            sprintf_s(f[2], sizeof(f[2]), "%.3f", (double)hw->instructions / hw->cycles);
+        else f[2][0] = '\0';
+
+        fprintf(fp, "%s,%s,%s,%d,%ld,%ld,%.8f,%s,%s,%s,%s,%s,%s,%s\n",
             timeStr,
             getDistName(type),
             results[i].algorithm,
             results[i].dataSize,
             results[i].compareCount,
             results[i].moveCount,
-            results[i].timeCost);
+            results[i].timeCost,
+            f[0], f[1], f[2], f[3], f[4], f[5], f[6]);
     }
 
     fclose(fp);
@@ -409,23 +675,40 @@ void saveResultsToFile(SortPerformance results[], int count, int type) {
 
 // 㷨
 SortPerformance testAlgorithm(void (*sortFunc)(int*, int), int rawData[], int n, char* name) {
-    int* arr = (int*)malloc(n * sizeof(int));
+    SortPerformance sp;
+    memset(&sp, 0, sizeof(sp));
+    strcpy_s(sp.algorithm, sizeof(sp.algorithm), name);
+    sp.dataSize = n;
+
+    // ݸʱ嶼Թʱڲз
+    int* arr = workspaceGet(WS_DATA, n);
+    if (!arr || !workspaceGet(WS_TEMP, n)) {
+        printf("ڴ治\n");
+        return sp;
+    }
     copyArray(rawData, arr, n);
 
     g_compareCount = 0;
     g_moveCount = 0;
+    g_passCount = 0;
 
+    visualizeBegin(arr, n);
+    // ֻ߳ͳƱ̣߳Ⱦ̵߳ʱƬ
+    ULONG64 cyclesStart = 0, cyclesEnd = 0;
+    BOOL hasCycles = QueryThreadCycleTime(GetCurrentThread(), &cyclesStart);
     long long start = getTick();
     sortFunc(arr, n);
     long long end = getTick();
+    hasCycles = hasCycles && QueryThreadCycleTime(GetCurrentThread(), &cyclesEnd);
+    visualizeEnd(arr, n);
 
-    SortPerformance sp;
-    strcpy_s(sp.algorithm, sizeof(sp.algorithm), name);
-    sp.dataSize = n;
     sp.compareCount = g_compareCount;
     sp.moveCount = g_moveCount;
+    sp.passes = g_passCount;
     sp.timeCost = calcDuration(start, end);
-
-    free(arr);
+    if (hasCycles) {
+        sp.hw.valid = HW_CYCLES;
+        sp.hw.cycles = (long long)(cyclesEnd - cyclesStart);
+    }
     return sp;
 }
\ No newline at end of file
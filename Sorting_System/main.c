@@ -2,8 +2,9 @@
 
 long g_compareCount = 0;
 long g_moveCount = 0;
+int g_passCount = 0;
 int g_visualize = 0;
-int g_delay = 1000;
+int g_fps = 30;
 LARGE_INTEGER g_cpuFreq;
 
 // 6. 
@@ -14,6 +15,7 @@ int main() {
     int type = 0; // 0-Random, 1-Sorted, 2-Reverse
 
     initTimer();
+    srand((unsigned)time(NULL));
     rawData = (int*)malloc(n * sizeof(int));
     generateData(rawData, n, type);
 
@@ -23,7 +25,7 @@ int main() {
         printf("============================================\n");
         printf("1. ùģ/ (ǰ: %d, : %s)\n", n, getDistName(type));
         printf("2. \n");
-        printf("3. лӻ (ǰ: %s)\n", g_visualize ? "" : "ر");
+        printf("3. лӻ (ǰ: %s, %d ֡/)\n", g_visualize ? "" : "ر", g_fps);
         printf("4. 㷨\n");
         printf("5. ȫ㷨Ա (ԶCSV)\n");
         printf("0. ˳\n");
@@ -58,9 +60,14 @@ int main() {
         }
         case 3:
             g_visualize = !g_visualize;
+            if (g_visualize) {
+                printf("ˢ (֡/): ");
+                scanf_s("%d", &g_fps);
+                if (g_fps <= 0) g_fps = 30;
+            }
             break;
         case 4: {
-            printf("㷨: 1.ð 2. 3.ѡ 4. 5.ϣ 6. 7.鲢: ");
+            printf("㷨: 1.ð 2. 3.ѡ 4. 5.ϣ 6. 7.鲢 8.: ");
             int algo; scanf_s("%d", &algo);
             SortPerformance sp;
             memset(&sp, 0, sizeof(sp));
@@ -72,18 +79,21 @@ int main() {
             else if (algo == 5) sp = testAlgorithm(ShellSort, rawData, n, "Shell");
             else if (algo == 6) sp = testAlgorithm(HeapSort, rawData, n, "Heap");
             else if (algo == 7) sp = testAlgorithm(MergeSort, rawData, n, "Merge");
+            else if (algo == 8) sp = testAlgorithm(RadixSort, rawData, n, "Radix");
             else { printf("Чѡ\n"); break; }
 
-            printf("\n--- : %s ---\nȽ: %ld\nƶ: %ld\nʱ: %.8f \n",
-                sp.algorithm, sp.compareCount, sp.moveCount, sp.timeCost);
+            char cycles[24];
+            formatCounter(cycles, sizeof(cycles), &sp.hw, HW_CYCLES, sp.hw.cycles);
+            printf("\n--- : %s ---\nȽ: %ld\nƶ: %ld\n: %d\nʱ: %.8f \n: %s\n",
+                sp.algorithm, sp.compareCount, sp.moveCount, sp.passes, sp.timeCost, cycles);
             break;
         }
         case 5: {
             int oldVis = g_visualize;
             g_visualize = 0; // ǿƹرտӻԲ
 
-            printf("ڶԱ7㷨 (ģ: %d, : %s)...\n", n, getDistName(type));
-            SortPerformance results[7];
+            printf("ڶԱ8㷨 (ģ: %d, : %s)...\n", n, getDistName(type));
+            SortPerformance results[8];
 
             results[0] = testAlgorithm(BubbleSort, rawData, n, "Bubble");
             results[1] = testAlgorithm(InsertSort, rawData, n, "Insert");
@@ -92,17 +102,25 @@ int main() {
             results[4] = testAlgorithm(ShellSort, rawData, n, "Shell");
             results[5] = testAlgorithm(HeapSort, rawData, n, "Heap");
             results[6] = testAlgorithm(MergeSort, rawData, n, "Merge");
+            results[7] = testAlgorithm(RadixSort, rawData, n, "Radix");
 
-            printf("\n%-15s %-12s %-12s %-15s\n", "Algo", "Compares", "Moves", "Time(s)");
-            printf("------------------------------------------------------\n");
-            for (int i = 0; i < 7; i++) {
-                printf("%-15s %-12ld %-12ld %-15.8f\n",
+            printf("\n%-15s %-12s %-12s %-8s %-15s %-14s %-10s\n", "Algo", "Compares", "Moves", "Passes", "Time(s)",
+                "Cycles", "Cyc/Elem");
+            printf("------------------------------------------------------------------------------------------\n");
+            for (int i = 0; i < 8; i++) {
+                char cycles[24], perElem[24];
+                formatCounter(cycles, sizeof(cycles), &results[i].hw, HW_CYCLES, results[i].hw.cycles);
+                if ((results[i].hw.valid & HW_CYCLES) && n > 0)
+                    sprintf_s(perElem, sizeof(perElem), "%.1f", (double)results[i].hw.cycles / n);
+                else sprintf_s(perElem, sizeof(perElem), "n/a");
+                printf("%-15s %-12ld %-12ld %-8d %-15.8f %-14s %-10s\n",
                     results[i].algorithm, results[i].compareCount,
-                    results[i].moveCount, results[i].timeCost);
+                    results[i].moveCount, results[i].passes, results[i].timeCost, cycles, perElem);
             }
+            printf("(IPC֧Ԥ뻺/TLB δҪ PMU ʣWindows û̬ãCSV )\n");
 
             // ʱ type
-            saveResultsToFile(results, 7, type);
+            saveResultsToFile(results, 8, type);
 
             g_visualize = oldVis;
             system("pause");
@@ -110,6 +128,7 @@ int main() {
         }
         case 0:
             free(rawData);
+            workspaceFree();
             return 0;
         default:
             printf("Ч\n");
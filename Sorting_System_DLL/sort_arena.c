@@ -0,0 +1,180 @@
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif
+
+#include "sort_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ʱڴأ߳У SortContext.arena ϡ
+// һڵʱ尴 64 ֽڶг黹 (ͷ)
+// Ŀ˻ mallocͬʱݣ
+// ͬһģӵڶٵ÷Ҳٲȱҳ
+// ڴֱϵͳӳ䣺ѡҳ (ʽҳʧʱ Linux Ϊ͸ҳ)ѡԤȴȫҳ档
+
+#define ARENA_ALIGN 64
+#define ARENA_PAGE 4096
+#define ARENA_HUGE_PAGE (2u << 20)
+
+struct SortArena {
+    char* base;
+    size_t capacity;
+    size_t mapped;           // ʵӳֽ (ҳҳȡ)
+    size_t used;             // гֽ
+    size_t demand;           //  (˻ malloc Ĳ)
+    int flags;
+    int hugePages;
+    long long highWater;
+    long long fallbacks;
+    long long grows;
+};
+
+static size_t round_up(size_t x, size_t a) {
+    return (x + a - 1) / a * a;
+}
+
+// 1. ϵͳӳ/ͷ
+static void region_free(SortArena* a) {
+    if (!a->base) return;
+#ifdef _WIN32
+    VirtualFree(a->base, 0, MEM_RELEASE);
+#else
+    munmap(a->base, a->mapped);
+#endif
+    a->base = NULL;
+    a->capacity = 0;
+    a->mapped = 0;
+    a->hugePages = 0;
+}
+
+// ӳ򣬳ɹͷžʧʱԭֲ
+static int region_map(SortArena* a, size_t bytes) {
+    if (bytes == 0) {
+        region_free(a);
+        return 0;
+    }
+    void* p = NULL;
+    size_t size = round_up(bytes, ARENA_PAGE);
+    int huge = 0;
+#ifdef _WIN32
+    if (a->flags & SORT_ARENA_HUGE_PAGES) {
+        // Ҫ "ڴҳ" Ȩޣûʱʧܲ˻ͨҳ
+        SIZE_T large = GetLargePageMinimum();
+        if (large > 0) {
+            size_t hugeSize = round_up(bytes, large);
+            p = VirtualAlloc(NULL, hugeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p) {
+                size = hugeSize;
+                huge = SORT_ARENA_HUGE_EXPLICIT;
+            }
+        }
+    }
+    if (!p) p = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!p) return -1;
+#else
+#ifdef MAP_HUGETLB
+    if (a->flags & SORT_ARENA_HUGE_PAGES) {
+        size_t hugeSize = round_up(bytes, ARENA_HUGE_PAGE);
+        p = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            p = NULL;
+        }
+        else {
+            size = hugeSize;
+            huge = SORT_ARENA_HUGE_EXPLICIT;
+        }
+    }
+#endif
+    if (!p) {
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return -1;
+#ifdef MADV_HUGEPAGE
+        // ûԤʽҳʱں͸ҳ
+        if ((a->flags & SORT_ARENA_HUGE_PAGES) && madvise(p, size, MADV_HUGEPAGE) == 0) {
+            huge = SORT_ARENA_HUGE_TRANSPARENT;
+        }
+#endif
+    }
+#endif
+    region_free(a);
+    a->base = (char*)p;
+    a->mapped = size;
+    a->capacity = size;
+    a->hugePages = huge;
+    // Ԥȴȱҳڼʱ
+    if (a->flags & SORT_ARENA_PREFAULT) {
+        for (size_t i = 0; i < size; i += ARENA_PAGE) a->base[i] = 0;
+    }
+    return 0;
+}
+
+// 2. ӿ
+EXPORT SortArena* sort_arena_create(long long bytes, int flags) {
+    if (bytes < 0) return NULL;
+    SortArena* a = (SortArena*)calloc(1, sizeof(SortArena));
+    if (!a) return NULL;
+    a->flags = flags;
+    if (region_map(a, (size_t)bytes) != 0) {
+        free(a);
+        return NULL;
+    }
+    return a;
+}
+
+EXPORT int sort_arena_reserve(SortArena* a, long long bytes) {
+    if (!a || bytes < 0) return -1;
+    if ((size_t)bytes <= a->capacity) return 0;
+    a->grows++;
+    return region_map(a, (size_t)bytes);
+}
+
+EXPORT void sort_arena_info(const SortArena* a, SortArenaInfo* info) {
+    if (!info) return;
+    memset(info, 0, sizeof(*info));
+    if (!a) return;
+    info->capacity = (long long)a->capacity;
+    info->highWater = a->highWater;
+    info->fallbacks = a->fallbacks;
+    info->grows = a->grows;
+    info->hugePages = a->hugePages;
+}
+
+EXPORT void sort_arena_destroy(SortArena* a) {
+    if (!a) return;
+    region_free(a);
+    free(a);
+}
+
+// 3. ڲʹ
+void* arena_alloc(SortArena* a, size_t bytes) {
+    size_t need = round_up(bytes > 0 ? bytes : 1, ARENA_ALIGN);
+    a->demand += need;
+    if (!a->base || a->used + need > a->capacity) {
+        a->fallbacks++;
+        return NULL;
+    }
+    void* p = a->base + a->used;
+    a->used += need;
+    return p;
+}
+
+int arena_owns(const SortArena* a, const void* p) {
+    return a->base && (const char*)p >= a->base && (const char*)p < a->base + a->capacity;
+}
+
+void arena_end_run(SortArena* a) {
+    if ((long long)a->demand > a->highWater) a->highWater = (long long)a->demand;
+    // ʧܾͱԭ´˻ malloc
+    if (a->demand > a->capacity) {
+        a->grows++;
+        region_map(a, a->demand);
+    }
+    a->used = 0;
+    a->demand = 0;
+}
@@ -0,0 +1,457 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Ӧ򣺵ٰ߲㷨Ȼ O(n/64) ʱ
+// жϣ
+//   1.  (ٸı) -> TimSort///ٹӽ O(n)
+//   2. ֵС (ƺɨһȷ) -> 
+//   3. ģ㹻ж߳ -> 㷨
+//   4. ģ㹻ظֵ -> 
+//   5.  -> pdqsort (ʡʽţ O(n log n))
+// ֵ죬У׼ڱϲĽдļ
+// һʹʱأûļʱĬֵ
+
+#define AUTO_MIN_N 256           // Сڴ˹ģֱ pdqsort (С򣬶)
+#define AUTO_SAMPLE_RATE 64      // ÿ 64 Ԫȡһ
+#define AUTO_SAMPLE_MIN 16
+#define AUTO_SAMPLE_MAX 4096
+#define AUTO_DEFAULT_FILE "sort_tuning.txt"
+#define CALIB_REPS 5             // У׼ʱÿȡ̺ʱĴ
+#define CALIB_MID_N (1 << 18)    // ģ޹صֵڴ˹ģϲ
+
+// 1. Ų
+static SortTuning g_tuning;
+
+EXPORT void sort_tuning_defaults(SortTuning* t) {
+    if (!t) return;
+    memset(t, 0, sizeof(*t));
+    t->runRatio = 0.01;
+    t->countRatio = 4.0;
+    t->duplicateRatio = 0.5;
+    t->radixMinN = 1 << 12;
+    t->parallelMinN = 1 << 20;
+    t->parallelAlgo = SORT_PARALLEL_MERGE;
+    t->calibrated = 0;
+}
+
+static void tuning_clamp(SortTuning* t) {
+    if (!(t->runRatio >= 0)) t->runRatio = 0;
+    if (t->runRatio > 0.5) t->runRatio = 0.5;
+    if (!(t->countRatio >= 0)) t->countRatio = 0;
+    if (t->countRatio > COUNTING_MAX_RATIO) t->countRatio = COUNTING_MAX_RATIO;
+    if (!(t->duplicateRatio >= 0)) t->duplicateRatio = 0;
+    if (t->duplicateRatio > 1) t->duplicateRatio = 1;
+    if (t->radixMinN < 0) t->radixMinN = 0;
+    if (t->parallelMinN < 0) t->parallelMinN = 0;
+    if (t->parallelAlgo != SORT_PARALLEL_MERGE && t->parallelAlgo != SORT_PARALLEL_QUICK) {
+        t->parallelAlgo = SORT_PARALLEL_MERGE;
+    }
+}
+
+static FILE* open_file(const char* path, const char* mode) {
+#ifdef _WIN32
+    FILE* fp = NULL;
+    if (fopen_s(&fp, path, mode) != 0) return NULL;
+    return fp;
+#else
+    return fopen(path, mode);
+#endif
+}
+
+// ļÿ " = ֵ"# ͷΪעͣδ֪ļ
+EXPORT int sort_tuning_load(const char* path, SortTuning* t) {
+    if (!path || !t) return -1;
+    FILE* fp = open_file(path, "r");
+    if (!fp) return -1;
+    sort_tuning_defaults(t);
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        char* eq = strchr(line, '=');
+        if (line[0] == '#' || !eq) continue;
+        *eq = '\0';
+        char key[64];
+        if (sscanf(line, " %63s", key) != 1) continue;
+        const char* value = eq + 1;
+        while (*value == ' ' || *value == '\t') value++;
+
+        if (strcmp(key, "run_ratio") == 0) t->runRatio = atof(value);
+        else if (strcmp(key, "count_ratio") == 0) t->countRatio = atof(value);
+        else if (strcmp(key, "duplicate_ratio") == 0) t->duplicateRatio = atof(value);
+        else if (strcmp(key, "radix_min_n") == 0) t->radixMinN = atoi(value);
+        else if (strcmp(key, "parallel_min_n") == 0) t->parallelMinN = atoi(value);
+        else if (strcmp(key, "parallel_algo") == 0) {
+            t->parallelAlgo = strncmp(value, "quick", 5) == 0 ? SORT_PARALLEL_QUICK : SORT_PARALLEL_MERGE;
+        }
+        else if (strcmp(key, "calibrated") == 0) t->calibrated = atoi(value);
+    }
+    fclose(fp);
+    tuning_clamp(t);
+    return 0;
+}
+
+EXPORT int sort_tuning_save(const char* path, const SortTuning* t) {
+    if (!path || !t) return -1;
+    FILE* fp = open_file(path, "w");
+    if (!fp) return -1;
+    fprintf(fp, "# auto_sort tuning profile (sort_calibrate), %d hardware threads, simd level %d\n",
+        pool_hardware_threads(), sort_simd_level());
+    fprintf(fp, "# 0 disables a rule; run_ratio/duplicate_ratio are sample fractions, count_ratio is range / n\n");
+    fprintf(fp, "run_ratio = %.4f\n", t->runRatio);
+    fprintf(fp, "count_ratio = %.2f\n", t->countRatio);
+    fprintf(fp, "duplicate_ratio = %.4f\n", t->duplicateRatio);
+    fprintf(fp, "radix_min_n = %d\n", t->radixMinN);
+    fprintf(fp, "parallel_min_n = %d\n", t->parallelMinN);
+    fprintf(fp, "parallel_algo = %s\n", t->parallelAlgo == SORT_PARALLEL_QUICK ? "quick" : "merge");
+    fprintf(fp, "calibrated = %d\n", t->calibrated);
+    int ok = ferror(fp) == 0;
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+// ļ· SORT_TUNING_FILEûΪǰĿ¼µ sort_tuning.txt
+static void tuning_init_once(void) {
+    char path[512];
+    const char* file = AUTO_DEFAULT_FILE;
+#ifdef _WIN32
+    DWORD len = GetEnvironmentVariableA("SORT_TUNING_FILE", path, sizeof(path));
+    if (len > 0 && len < sizeof(path)) file = path;
+#else
+    const char* env = getenv("SORT_TUNING_FILE");
+    if (env && *env && strlen(env) < sizeof(path)) {
+        strcpy(path, env);
+        file = path;
+    }
+#endif
+    if (sort_tuning_load(file, &g_tuning) != 0) sort_tuning_defaults(&g_tuning);
+}
+
+#ifdef _WIN32
+static INIT_ONCE g_tuningOnce = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK tuning_init_callback(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once; (void)param; (void)ctx;
+    tuning_init_once();
+    return TRUE;
+}
+static void tuning_init(void) { InitOnceExecuteOnce(&g_tuningOnce, tuning_init_callback, NULL, NULL); }
+#else
+static pthread_once_t g_tuningOnce = PTHREAD_ONCE_INIT;
+static void tuning_init(void) { pthread_once(&g_tuningOnce, tuning_init_once); }
+#endif
+
+EXPORT void sort_tuning_get(SortTuning* t) {
+    if (!t) return;
+    tuning_init();
+    *t = g_tuning;
+}
+
+EXPORT void sort_tuning_set(const SortTuning* t) {
+    if (!t) return;
+    tuning_init();   // ɼأ֮󲻻ٱļ
+    SortTuning v = *t;
+    tuning_clamp(&v);
+    g_tuning = v;
+}
+
+// 2. 
+//  [0, n - 2) Ϊ m 飬ÿȡһλ (ƫɹ̶ӵαݵغ)
+// λԪرȽϵõֲ (TimSort ı䴦ʼµĶ)
+// ȡֵõظֵ
+// counted ʱüȽ/ƶۼӵ cmp/moves
+static void sample_features(const int* arr, int n, SortFeatures* f, int counted, long long* cmp, long long* moves) {
+    memset(f, 0, sizeof(*f));
+    if (n < 3) {
+        if (n > 0) {
+            f->sampleMin = arr[0] < arr[n - 1] ? arr[0] : arr[n - 1];
+            f->sampleMax = arr[0] < arr[n - 1] ? arr[n - 1] : arr[0];
+        }
+        return;
+    }
+    int m = n / AUTO_SAMPLE_RATE;
+    if (m < AUTO_SAMPLE_MIN) m = AUTO_SAMPLE_MIN;
+    if (m > AUTO_SAMPLE_MAX) m = AUTO_SAMPLE_MAX;
+    if (m > n - 2) m = n - 2;
+
+    int sample[AUTO_SAMPLE_MAX];
+    long long block = (long long)(n - 2) / m;
+    unsigned long long state = 0x9E3779B97F4A7C15ull;
+    int descents = 0, turns = 0;
+    for (int k = 0; k < m; k++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        long long p = k * block + (long long)((state >> 33) % (unsigned long long)block);
+        int down1 = arr[p + 1] < arr[p];
+        int down2 = arr[p + 2] < arr[p + 1];
+        descents += down1;
+        turns += down1 != down2;
+        sample[k] = arr[p];
+    }
+
+    if (counted) {
+        long long c, mv;
+        stats_take(&c, &mv);   // ʱκһμʱУ̼߳Խ
+        _PdqSort(sample, m);
+        stats_take(&c, &mv);
+        *cmp += c + 2 * m + (m - 1);
+        *moves += mv + m;
+    }
+    else {
+        _PdqSortFast(sample, m);
+    }
+
+    int dups = 0;
+    for (int k = 1; k < m; k++) dups += sample[k] == sample[k - 1];
+
+    f->samples = m;
+    f->runRatio = (double)turns / m;
+    f->descentRatio = (double)descents / m;
+    f->duplicateRatio = (double)dups / m;
+    f->sampleMin = sample[0];
+    f->sampleMax = sample[m - 1];
+    f->rangeRatio = ((double)sample[m - 1] - sample[0] + 1) / n;
+}
+
+EXPORT int sort_auto_analyze(const int* arr, int n, SortFeatures* f) {
+    if ((!arr && n > 0) || n < 0 || !f) return -1;
+    long long cmp = 0, moves = 0;
+    sample_features(arr, n, f, 0, &cmp, &moves);
+    return 0;
+}
+
+// 3. ѡ
+static int choose_algo(const SortTuning* t, const int* arr, int n, int threads, const SortFeatures* f) {
+    if (n < AUTO_MIN_N) return SORT_PDQ;
+
+    if (t->runRatio > 0 && f->runRatio <= t->runRatio) return SORT_TIM;
+
+    if (t->countRatio > 0 && f->rangeRatio <= t->countRatio) {
+        // ©Ⱥֵɨһȷʵֵ
+        int lo = arr[0], hi = arr[0];
+        for (int i = 1; i < n; i++) {
+            int v = arr[i];
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+        }
+        if ((double)hi - lo + 1 <= t->countRatio * n) return SORT_COUNTING;
+    }
+
+    if (threads <= 0) threads = pool_hardware_threads();
+    if (t->parallelMinN > 0 && n >= t->parallelMinN && threads > 1) return t->parallelAlgo;
+
+    if (t->radixMinN > 0 && n >= t->radixMinN && f->duplicateRatio < t->duplicateRatio) return SORT_RADIX;
+
+    return SORT_PDQ;
+}
+
+EXPORT int sort_auto_choose(const int* arr, int n, int threads) {
+    if ((!arr && n > 0) || n < 0) return -1;
+    tuning_init();
+    SortTuning t = g_tuning;
+    SortFeatures f;
+    memset(&f, 0, sizeof(f));
+    long long cmp = 0, moves = 0;
+    if (n >= AUTO_MIN_N) sample_features(arr, n, &f, 0, &cmp, &moves);
+    return choose_algo(&t, arr, n, threads, &f);
+}
+
+// ѡĺʱȽϴalgorithm Ϊ "Auto: " ѡ
+int auto_dispatch(SortContext* ctx, int* arr, int n) {
+    tuning_init();
+    SortTuning t = g_tuning;
+    int counted = !(ctx->options & SORT_OPT_FAST);
+
+    long long cmp = 0, moves = 0;
+    double start = get_time_ms();
+    int algo = SORT_PDQ;
+    if (n >= AUTO_MIN_N) {
+        SortFeatures f;
+        sample_features(arr, n, &f, counted, &cmp, &moves);
+        algo = choose_algo(&t, arr, n, ctx->threads, &f);
+    }
+    double analyzeMs = get_time_ms() - start;
+
+    int ret = sort_run(ctx, algo, arr, n);
+    if (ret != 0) return ret;
+
+    SortPerformance* sp = &ctx->stats;
+    char name[sizeof(sp->algorithm) + 8];
+    snprintf(name, sizeof(name), "Auto: %s", sp->algorithm);
+    memcpy(sp->algorithm, name, sizeof(sp->algorithm) - 1);
+    sp->algorithm[sizeof(sp->algorithm) - 1] = '\0';
+    sp->compareCount += cmp;
+    sp->moveCount += moves;
+    sp->timeCost += analyzeMs;
+    return 0;
+}
+
+// 4. У׼
+// ÿֵĽ㣺һĹģ () Ϸֱʱ (㿪棬ȡ̺ʱ)
+// һңֵȡ"һֱ"Сֵһζرոù
+typedef struct {
+    int* src;
+    int* work;
+    unsigned long long seed;
+} CalibState;
+
+static double time_algo(const CalibState* s, int algo, int n) {
+    double best = 0;
+    for (int r = 0; r < CALIB_REPS; r++) {
+        memcpy(s->work, s->src, (size_t)n * sizeof(int));
+        SortContext ctx;
+        sort_context_init(&ctx);
+        ctx.options = SORT_OPT_FAST;
+        sort_run(&ctx, algo, s->work, n);
+        if (r == 0 || ctx.stats.timeCost < best) best = ctx.stats.timeCost;
+    }
+    return best;
+}
+
+//  TimSort/ʱĵ߳Ѻʱ
+static double time_general(const CalibState* s, int n) {
+    double pdq = time_algo(s, SORT_PDQ, n);
+    double radix = time_algo(s, SORT_RADIX, n);
+    return pdq < radix ? pdq : radix;
+}
+
+// wins[0..count) УһΪ㣬ĩΪʱ -1
+static int crossover(const int wins[], int count) {
+    int i = count;
+    while (i > 0 && wins[i - 1]) i--;
+    return i == count ? -1 : i;
+}
+
+#define CALIB_MAX_STEPS 24
+
+static void calib_radix(CalibState* s, int maxN, SortTuning* t) {
+    int sizes[CALIB_MAX_STEPS], wins[CALIB_MAX_STEPS], count = 0;
+    for (long long n = 1 << 10; count < CALIB_MAX_STEPS; n *= 2) {
+        if (n > maxN) n = maxN;
+        generate_data_ex(s->src, (int)n, GEN_FULL_RANGE, s->seed, 0, 0);
+        sizes[count] = (int)n;
+        wins[count] = time_algo(s, SORT_RADIX, (int)n) < time_algo(s, SORT_PDQ, (int)n);
+        count++;
+        if (n == maxN) break;
+    }
+    int i = crossover(wins, count);
+    t->radixMinN = i < 0 ? 0 : sizes[i];
+}
+
+static void calib_duplicates(CalibState* s, int n, SortTuning* t) {
+    // ֵͬӶൽ٣ظ֮
+    const int distincts[] = { n / 2, n / 16, n / 128, 1024, 256, 64, 16, 4 };
+    int count = (int)(sizeof(distincts) / sizeof(distincts[0]));
+    double ratios[8];
+    int wins[8];
+    for (int i = 0; i < count; i++) {
+        int distinct = distincts[i] > 2 ? distincts[i] : 2;
+        generate_data_ex(s->src, n, GEN_FEW_UNIQUE, s->seed, distinct, 0);
+        SortFeatures f;
+        sort_auto_analyze(s->src, n, &f);
+        ratios[i] = f.duplicateRatio;
+        wins[i] = time_algo(s, SORT_PDQ, n) < time_algo(s, SORT_RADIX, n);
+    }
+    int i = crossover(wins, count);
+    t->duplicateRatio = i < 0 ? 1.0 : ratios[i];
+}
+
+static void calib_counting(CalibState* s, int n, SortTuning* t) {
+    static const double ratios[] = { 0.25, 0.5, 1, 2, 4, 8 };
+    int count = (int)(sizeof(ratios) / sizeof(ratios[0]));
+    // ģֵ෴ֵԽСԽռţȡСʤ
+    int last = -1;
+    for (int i = 0; i < count; i++) {
+        int maxValue = (int)(ratios[i] * n);
+        generate_data_ex(s->src, n, GEN_RANDOM, s->seed, 0, maxValue > 1 ? maxValue : 2);
+        if (!(time_algo(s, SORT_COUNTING, n) < time_general(s, n))) break;
+        last = i;
+    }
+    t->countRatio = last < 0 ? 0 : ratios[last];
+}
+
+static void calib_runs(CalibState* s, int n, SortTuning* t) {
+    //  n * f ԪأŶԽֲԽ̡
+    // ֵȡ㹻ɢΪ (Сֵѡʱ TimSort)
+    static const double swaps[] = { 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1 };
+    int count = (int)(sizeof(swaps) / sizeof(swaps[0]));
+    unsigned long long state = s->seed * 2862933555777941757ull + 3037000493ull;
+    int last = -1;
+    double ratio = 0;
+    unsigned step = 0x7fffffffu / (unsigned)n;
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < n; k++) s->src[k] = (int)((unsigned)k * step);
+        long long pairs = (long long)(n * swaps[i]);
+        for (long long k = 0; k < pairs; k++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            int a = (int)((state >> 33) % (unsigned)n);
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            int b = (int)((state >> 33) % (unsigned)n);
+            int tmp = s->src[a]; s->src[a] = s->src[b]; s->src[b] = tmp;
+        }
+        SortFeatures f;
+        sort_auto_analyze(s->src, n, &f);
+        if (!(time_algo(s, SORT_TIM, n) < time_general(s, n))) break;
+        last = i;
+        if (f.runRatio > ratio) ratio = f.runRatio;
+    }
+    // ŶʱһתûУֵٱ"ȫ"һ (0 ʾر)
+    if (last >= 0 && ratio < 1.0 / AUTO_SAMPLE_MAX) ratio = 1.0 / AUTO_SAMPLE_MAX;
+    t->runRatio = last < 0 ? 0 : ratio;
+}
+
+static void calib_parallel(CalibState* s, int maxN, SortTuning* t) {
+    t->parallelMinN = 0;
+    if (pool_hardware_threads() < 2) return;
+    int sizes[CALIB_MAX_STEPS], wins[CALIB_MAX_STEPS], count = 0;
+    int algo = SORT_PARALLEL_MERGE;
+    for (long long n = 1 << 16; count < CALIB_MAX_STEPS; n *= 2) {
+        if (n > maxN) n = maxN;
+        generate_data_ex(s->src, (int)n, GEN_FULL_RANGE, s->seed, 0, 0);
+        double merge = time_algo(s, SORT_PARALLEL_MERGE, (int)n);
+        double quick = time_algo(s, SORT_PARALLEL_QUICK, (int)n);
+        algo = merge <= quick ? SORT_PARALLEL_MERGE : SORT_PARALLEL_QUICK;   // ģϵĽΪ׼
+        sizes[count] = (int)n;
+        wins[count] = (merge < quick ? merge : quick) < time_general(s, (int)n);
+        count++;
+        if (n == maxN) break;
+    }
+    int i = crossover(wins, count);
+    t->parallelMinN = i < 0 ? 0 : sizes[i];
+    t->parallelAlgo = algo;
+}
+
+EXPORT int sort_calibrate(int maxN, const char* path, SortTuning* out) {
+    if (maxN <= 0) maxN = 1 << 20;
+    if (maxN < AUTO_MIN_N) maxN = AUTO_MIN_N;
+    CalibState s;
+    s.src = (int*)malloc((size_t)maxN * sizeof(int));
+    s.work = (int*)malloc((size_t)maxN * sizeof(int));
+    s.seed = 1;
+    if (!s.src || !s.work) {
+        free(s.src);
+        free(s.work);
+        return -1;
+    }
+
+    SortTuning t;
+    sort_tuning_defaults(&t);
+    int mid = maxN < CALIB_MID_N ? maxN : CALIB_MID_N;
+    calib_radix(&s, maxN, &t);
+    calib_duplicates(&s, mid, &t);
+    calib_counting(&s, mid, &t);
+    calib_runs(&s, maxN, &t);   // TimSort Ĳģ仯ģϲ
+    calib_parallel(&s, maxN, &t);
+    t.calibrated = 1;
+    free(s.src);
+    free(s.work);
+
+    sort_tuning_set(&t);
+    if (out) *out = t;
+    if (path && sort_tuning_save(path, &t) != 0) return -1;
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// СһεƽͬһеĴ̶Ρ
+// Ȱȷּ ( /  / pdqsort)ͬһĶ
+// ٰԪѴ˳ָ̣߳ʡȥεõ FFIʱڴ俪
+
+#define BATCH_INSERT 8           // óȵĶò
+#define BATCH_PAR_MIN 65536      // Ԫùģʱ
+#define BATCH_PIECES_PER_THREAD 4
+
+enum { CLASS_INSERT, CLASS_NETWORK, CLASS_PDQ, CLASS_COUNT };
+
+typedef struct {
+    int* data;
+    const int* offsets;      // Ϊ NULL ʱ segLength з
+    int segLength;
+    int n;
+    int segments;
+    const int* order;        // źõĶκţΪ NULL ʱԭ˳
+    const long long* cut;    // ÿ order еֹλ (pieces + 1 )
+    int fast;
+} BatchJob;
+
+// 1. ں
+static void insert_small(int* a, int n) {
+    for (int i = 1; i < n; i++) {
+        int v = a[i], j = i - 1;
+        while (j >= 0 && a[j] > v) {
+            a[j + 1] = a[j];
+            j--;
+        }
+        a[j + 1] = v;
+    }
+}
+
+static int size_class(int len) {
+    if (len <= BATCH_INSERT) return CLASS_INSERT;
+    if (len <= SIMD_NET_MAX) return CLASS_NETWORK;
+    return CLASS_PDQ;
+}
+
+// 治 SIMD 磬Ƚ/ƶε pdq_sort һ
+static void sort_segment(int* a, int len, int fast) {
+    if (len < 2) return;
+    if (!fast) {
+        _PdqSort(a, len);
+        return;
+    }
+    switch (size_class(len)) {
+    case CLASS_INSERT: insert_small(a, len); break;
+    case CLASS_NETWORK: simd_network_sort(a, len); break;
+    default: _PdqSortFast(a, len); break;
+    }
+}
+
+static void segment_range(const BatchJob* job, int seg, int* begin, int* len) {
+    if (job->offsets) {
+        *begin = job->offsets[seg];
+        *len = job->offsets[seg + 1] - job->offsets[seg];
+    }
+    else {
+        *begin = seg * job->segLength;
+        *len = job->n - *begin < job->segLength ? job->n - *begin : job->segLength;
+    }
+}
+
+static void batch_piece(void* arg, int index) {
+    const BatchJob* job = (const BatchJob*)arg;
+    for (long long k = job->cut[index]; k < job->cut[index + 1]; k++) {
+        int seg = job->order ? job->order[k] : (int)k;
+        int begin, len;
+        segment_range(job, seg, &begin, &len);
+        sort_segment(job->data + begin, len, job->fast);
+    }
+}
+
+// 2. ȣκŰٰۼԪгɷ
+static int batch_run(BatchJob* job, int threads) {
+    int segs = job->segments;
+    int* order = NULL;
+    if (job->offsets) {
+        order = (int*)malloc((size_t)(segs > 0 ? segs : 1) * sizeof(int));
+        if (!order) return -1;
+        int start[CLASS_COUNT + 1] = { 0 };
+        for (int s = 0; s < segs; s++) start[size_class(job->offsets[s + 1] - job->offsets[s]) + 1]++;
+        for (int c = 0; c < CLASS_COUNT; c++) start[c + 1] += start[c];
+        for (int s = 0; s < segs; s++) order[start[size_class(job->offsets[s + 1] - job->offsets[s])]++] = s;
+    }
+    job->order = order;
+
+    if (threads <= 0) threads = pool_hardware_threads();
+    if (threads > POOL_MAX_THREADS) threads = POOL_MAX_THREADS;
+    if (job->n < BATCH_PAR_MIN) threads = 1;
+    int pieces = threads == 1 ? 1 : threads * BATCH_PIECES_PER_THREAD;
+    if (pieces > segs) pieces = segs > 0 ? segs : 1;
+
+    long long cutStack[POOL_MAX_THREADS * BATCH_PIECES_PER_THREAD + 1];
+    long long done = 0;
+    int p = 0;
+    cutStack[0] = 0;
+    for (long long k = 0; k < segs && p < pieces - 1; k++) {
+        int begin, len;
+        segment_range(job, order ? order[k] : (int)k, &begin, &len);
+        done += len;
+        if (done * pieces >= (long long)job->n * (p + 1)) cutStack[++p] = k + 1;
+    }
+    while (p < pieces) cutStack[++p] = segs;
+    job->cut = cutStack;
+
+    pool_parallel_for(pieces, threads, batch_piece, job);
+    free(order);
+    return 0;
+}
+
+static int batch_finish(BatchJob* job, int threads, SortPerformance* stats) {
+    long long cmp, moves;
+    stats_take(&cmp, &moves);
+    double start = get_time_ms();
+    if (batch_run(job, threads) != 0) return -1;
+    double ms = get_time_ms() - start;
+    stats_take(&cmp, &moves);
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        snprintf(stats->algorithm, sizeof(stats->algorithm), job->fast ? "Batch Sort (Fast)" : "Batch Sort");
+        stats->dataSize = job->n;
+        stats->compareCount = cmp;
+        stats->moveCount = moves;
+        stats->timeCost = ms;
+    }
+    return 0;
+}
+
+// 3. ӿ
+EXPORT int sort_batch(int* data, const int* offsets, int segments, int threads, int options, SortPerformance* stats) {
+    if (segments < 0 || (segments > 0 && !offsets)) return -1;
+    if (segments > 0 && offsets[0] < 0) return -1;
+    for (int s = 0; s < segments; s++) {
+        if (offsets[s + 1] < offsets[s]) return -1;
+    }
+    int n = segments > 0 ? offsets[segments] - offsets[0] : 0;
+    if (n > 0 && !data) return -1;
+
+    BatchJob job;
+    memset(&job, 0, sizeof(job));
+    job.data = data;
+    job.offsets = offsets;
+    job.n = n;
+    job.segments = segments;
+    job.fast = (options & SORT_OPT_FAST) != 0;
+    return batch_finish(&job, threads, stats);
+}
+
+EXPORT int sort_batch_fixed(int* data, int n, int segLength, int threads, int options, SortPerformance* stats) {
+    if (n < 0 || segLength <= 0 || (n > 0 && !data)) return -1;
+
+    BatchJob job;
+    memset(&job, 0, sizeof(job));
+    job.data = data;
+    job.segLength = segLength;
+    job.n = n;
+    job.segments = (int)(((long long)n + segLength - 1) / segLength);
+    job.fast = (options & SORT_OPT_FAST) != 0;
+    return batch_finish(&job, threads, stats);
+}
@@ -0,0 +1,833 @@
+// ׼Թ (ǽ)
+// ÿ (㷨, ģ, ֲ) ԤɴΣظʱ N Σ min/median/p95/stddev 
+// ÷: sort_bench [-n ģб] [-d ֲб] [-a 㷨б] [-w Ԥȴ] [-r ʱ] [-c CPU] [-o CSVļ]
+// ʾ: sort_bench -n 1000,100000 -d random,sorted -a quick,merge,heap -w 2 -r 15 -o bench.csv
+// ⲿ: sort_bench -x data.txt -m 64 -k 16 -T /tmp   (д data.txt.sorted)
+// : sort_bench -u 100,1000,10000 -n 100000   (ÿɴβѯһͼ)
+// Ӳ: sort_bench -a heap,merge -n 1000000 -H 1   (ڡIPC֧Ԥʧܡ/TLB δ)
+// ʱڴ: sort_bench -a merge,radix,tim -n 1000000 -A 2   ( 64 ֽڶĳأҳԤȴԱ -A 0 ĺʱȱҳ)
+// ӦУ׼: sort_bench -C sort_tuning.txt -n 1000000   (潻㲢ã֮ -a auto ѡ)
+// ʷ˼: sort_bench -S history.csv -b history.csv -R 5 -L abc123   (ʷеһζԱȣ׷ӱΣʱ˳Ϊ 3)
+// Linux : cc -O2 -o sort_bench sort_bench.c sort_engine.c sort_thread.c sort_simd.c sort_generate.c sort_io.c sort_external.c sort_merge.c sort_typed.c sort_batch.c sort_topk.c sort_btree.c sort_trace.c sort_hwcount.c sort_arena.c sort_auto.c sort_bench_history.c -lm -lpthread
+
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif
+
+#include "sort_engine.h"
+#include "sort_bench_history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+#define MAX_LIST 32
+
+// ɲ㷨 ( -> sort_run 㷨)
+typedef struct {
+    const char* key;
+    int algo;
+} BenchAlgo;
+
+static const BenchAlgo g_algos[] = {
+    { "bubble", SORT_BUBBLE },
+    { "insert", SORT_INSERTION },
+    { "select", SORT_SELECTION },
+    { "shell",  SORT_SHELL },
+    { "quick",  SORT_QUICK },
+    { "merge",  SORT_MERGE },
+    { "heap",   SORT_HEAP },
+    { "pmerge", SORT_PARALLEL_MERGE },
+    { "pquick", SORT_PARALLEL_QUICK },
+    { "radix",  SORT_RADIX },
+    { "pdq",    SORT_PDQ },
+    { "tim",    SORT_TIM },
+    { "ppmerge", SORT_PINGPONG },
+    { "ppmerge4", SORT_PINGPONG4 },
+    { "count",  SORT_COUNTING },
+    { "auto",   SORT_AUTO },
+};
+#define ALGO_COUNT ((int)(sizeof(g_algos) / sizeof(g_algos[0])))
+
+// ݷֲ ( -> generate_data_ex  type)
+typedef struct {
+    const char* key;
+    int type;
+} BenchDist;
+
+static const BenchDist g_dists[] = {
+    { "random",   GEN_RANDOM },
+    { "sorted",   GEN_SORTED },
+    { "reverse",  GEN_REVERSE },
+    { "nearly",   GEN_NEARLY_SORTED },
+    { "few",      GEN_FEW_UNIQUE },
+    { "organ",    GEN_ORGAN_PIPE },
+    { "sawtooth", GEN_SAWTOOTH },
+    { "zipf",     GEN_ZIPF },
+    { "full",     GEN_FULL_RANGE },
+};
+#define DIST_COUNT ((int)(sizeof(g_dists) / sizeof(g_dists[0])))
+
+// ʵְ汾
+enum { VARIANT_COUNTED = 1, VARIANT_FAST = 2, VARIANT_BOTH = 3 };
+
+// ָƣ± SortSimdLevel һ
+static const char* g_simdNames[] = { "none", "sse41", "avx2", "avx512" };
+#define SIMD_COUNT ((int)(sizeof(g_simdNames) / sizeof(g_simdNames[0])))
+
+// ѡ
+typedef struct {
+    int sizes[MAX_LIST]; int sizeCount;
+    int dists[MAX_LIST]; int distCount;   // g_dists ±
+    int algos[MAX_LIST]; int algoCount;   // g_algos ±
+    int warmup;
+    int reps;
+    int cpu;                              // <0 ʾ
+    int variant;                          // VARIANT_*
+    int threads;                          // 㷨߳0 ʾӲ߳
+    int simd;                             // ָޣ<0 ʾԶ
+    unsigned long long seed;              // 
+    const char* csvPath;
+    const char* externalPath;             //  NULL ʱΪԸļһⲿ
+    int memoryMb;                         // ⲿڴԤ (MB)
+    int fanIn;                            // ⲿ
+    const char* tempDir;                  // ⲿʱĿ¼
+    int ratios[MAX_LIST]; int ratioCount; // Ե /ѯ ȣ 0 ʱΪò
+    int hwCounters;                       //  0 ʱÿμʱͬʱɼӲ
+    int arena;                            // 0 ÿ malloc1 ڴأ2 ڴزʹôҳԤȴ
+    const char* historyPath;              // ʷ CSV NULL ʱ׷ӱȫ
+    const char* baselinePath;             // ʷ⣬ NULL ʱԱ
+    double threshold;                     // Ϊ˵λ (%)
+    const char* label;                    // дʷбǩ
+    const char* calibratePath;            //  NULL ʱΪУ׼Ӧ򲢱
+} BenchOptions;
+
+#define BENCH_ALPHA 0.01   // ˼ˮƽ
+
+// ʷ߶Աȵ״̬
+typedef struct {
+    FILE* history;
+    BenchHistory baseline;
+    int hasBaseline;
+    BenchFingerprint fp;
+    int threads;                          // ʵ߳ (0 ѻӲ߳)
+    double threshold;
+    int compared;
+    int regressions;
+    int improvements;
+} BenchTracker;
+
+static FILE* open_file(const char* path, const char* mode) {
+#ifdef _WIN32
+    FILE* fp = NULL;
+    if (fopen_s(&fp, path, mode) != 0) return NULL;
+    return fp;
+#else
+    return fopen(path, mode);
+#endif
+}
+
+// ǰ̰߳󶨵ָ CPUǨƴĻ涶cpu < 0 ʱָΪһΰǰ CPU 
+#ifdef _WIN32
+static DWORD_PTR g_startMask = 0;
+#else
+static cpu_set_t g_startCpus;
+static int g_hasStartCpus = 0;
+#endif
+
+static int pin_cpu(int cpu) {
+#ifdef _WIN32
+    if (cpu < 0) return g_startMask == 0 || SetThreadAffinityMask(GetCurrentThread(), g_startMask) != 0;
+    DWORD_PTR prev = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+    if (prev && !g_startMask) g_startMask = prev;
+    return prev != 0;
+#else
+    if (cpu < 0) return !g_hasStartCpus || sched_setaffinity(0, sizeof(g_startCpus), &g_startCpus) == 0;
+    if (!g_hasStartCpus) g_hasStartCpus = sched_getaffinity(0, sizeof(g_startCpus), &g_startCpus) == 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#endif
+}
+
+// ߳ԼҲȡĲ㷨 (Ӧѡв)
+// ʱ󶨣̶̹߳һ CPU ϣ⵽öǲչ
+static int is_parallel(int algo) {
+    return algo == SORT_PARALLEL_MERGE || algo == SORT_PARALLEL_QUICK || algo == SORT_AUTO;
+}
+
+static void usage(void) {
+    printf("÷: sort_bench [ѡ]\n");
+    printf("  -n LIST   ݹģ, ŷָ (Ĭ 1000,10000,100000)\n");
+    printf("  -d LIST   ݷֲ:");
+    for (int i = 0; i < DIST_COUNT; i++) printf(" %s", g_dists[i].key);
+    printf(" (Ĭ random)\n");
+    printf("  -a LIST   㷨:");
+    for (int i = 0; i < ALGO_COUNT; i++) printf(" %s", g_algos[i].key);
+    printf(" (Ĭ quick,merge,heap,shell)\n");
+    printf("  -w N      Ԥȴ (Ĭ 2)\n");
+    printf("  -r N      ʱ (Ĭ 11)\n");
+    printf("  -c N      󶨵 CPU N (㷨 auto ), -1  (Ĭ 0)\n");
+    printf("  -v MODE   counted | fast | both, both ʱ׮ (Ĭ both)\n");
+    printf("  -t N      㷨߳, 0 ΪӲ߳ (Ĭ 0)\n");
+    printf("  -s ISA    ָ:");
+    for (int i = 0; i < SIMD_COUNT; i++) printf(" %s", g_simdNames[i]);
+    printf(" (ĬԶ)\n");
+    printf("  -g SEED    (Ĭ 1)\n");
+    printf("  -o FILE   ׷ӽ CSV ļ\n");
+    printf("  -x FILE   ⲿļ (ı), д FILE.sorted\n");
+    printf("  -m MB     ⲿڴԤ (Ĭ 256)\n");
+    printf("  -k N      ⲿ (Ĭ 64)\n");
+    printf("  -T DIR    ⲿʱĿ¼ (ĬϵǰĿ¼)\n");
+    printf("  -H 0|1    ɼӲ (Linux perf_event, Windows ; Ĭ 0)\n");
+    printf("  -A 0|1|2  ʱ: 0 ÿ malloc, 1 ڴ, 2 ڴ + ҳ + Ԥȴ (Ĭ 0)\n");
+    printf("  -u LIST   : ÿ N βһβѯ, ŷָ;  \"׷Ӻ merge_sort\" Ա\n");
+    printf("  -S FILE   ׷ӽ뻷ָ (CPUӡμʱ) ʷ\n");
+    printf("  -b FILE   ʷͬһ CPU ϵһνԱ (˫ 5 μʱ), ʱ˳Ϊ 3\n");
+    printf("  -R PCT    Ϊ˵λֵ (Ĭ 5)\n");
+    printf("  -L TEXT   дʷбǩ, ύ\n");
+    printf("  -C FILE   У׼Ӧ (auto), ģȡ -n еֵ, ñ浽 FILE\n");
+}
+
+// Ʊвң±ꣻҲ -1
+static int find_key(const char* name, size_t len, const char* keys[], int count) {
+    for (int i = 0; i < count; i++) {
+        if (strlen(keys[i]) == len && strncmp(keys[i], name, len) == 0) return i;
+    }
+    return -1;
+}
+
+// ŷָбkeys Ϊ NULL ʱΪΪ±
+static int parse_list(const char* arg, int out[], const char* keys[], int keyCount) {
+    int count = 0;
+    const char* p = arg;
+    while (*p && count < MAX_LIST) {
+        const char* end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        int v;
+        if (keys) {
+            v = find_key(p, len, keys, keyCount);
+        }
+        else {
+            char* stop;
+            long x = strtol(p, &stop, 10);
+            v = (stop == p + len && x > 0 && x <= 0x7fffffff) ? (int)x : -1;
+        }
+        if (v < 0) {
+            printf("޷ʶĲ: %.*s\n", (int)len, p);
+            return -1;
+        }
+        out[count++] = v;
+        if (!end) break;
+        p = end + 1;
+    }
+    return count;
+}
+
+static int parse_options(int argc, char* argv[], BenchOptions* opt) {
+    const char* algoKeys[ALGO_COUNT];
+    const char* distKeys[DIST_COUNT];
+    for (int i = 0; i < ALGO_COUNT; i++) algoKeys[i] = g_algos[i].key;
+    for (int i = 0; i < DIST_COUNT; i++) distKeys[i] = g_dists[i].key;
+
+    memset(opt, 0, sizeof(*opt));
+    opt->sizeCount = parse_list("1000,10000,100000", opt->sizes, NULL, 0);
+    opt->distCount = parse_list("random", opt->dists, distKeys, DIST_COUNT);
+    opt->algoCount = parse_list("quick,merge,heap,shell", opt->algos, algoKeys, ALGO_COUNT);
+    opt->warmup = 2;
+    opt->reps = 11;
+    opt->cpu = 0;
+    opt->variant = VARIANT_BOTH;
+    opt->simd = -1;
+    opt->seed = 1;
+    opt->threshold = 5.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (strcmp(flag, "-h") == 0 || strcmp(flag, "--help") == 0) { usage(); return -1; }
+        if (flag[0] != '-' || flag[1] == '\0' || flag[2] != '\0' || i + 1 >= argc) {
+            printf("Ч: %s\n", flag);
+            usage();
+            return -1;
+        }
+        const char* val = argv[++i];
+        switch (flag[1]) {
+        case 'n': opt->sizeCount = parse_list(val, opt->sizes, NULL, 0); break;
+        case 'd': opt->distCount = parse_list(val, opt->dists, distKeys, DIST_COUNT); break;
+        case 'a': opt->algoCount = parse_list(val, opt->algos, algoKeys, ALGO_COUNT); break;
+        case 'w': opt->warmup = atoi(val); break;
+        case 'r': opt->reps = atoi(val); break;
+        case 'c': opt->cpu = atoi(val); break;
+        case 't': opt->threads = atoi(val); break;
+        case 'o': opt->csvPath = val; break;
+        case 'g': opt->seed = strtoull(val, NULL, 10); break;
+        case 'x': opt->externalPath = val; break;
+        case 'm': opt->memoryMb = atoi(val); break;
+        case 'k': opt->fanIn = atoi(val); break;
+        case 'T': opt->tempDir = val; break;
+        case 'H': opt->hwCounters = atoi(val); break;
+        case 'A': opt->arena = atoi(val); break;
+        case 'S': opt->historyPath = val; break;
+        case 'b': opt->baselinePath = val; break;
+        case 'R': opt->threshold = atof(val); break;
+        case 'L': opt->label = val; break;
+        case 'C': opt->calibratePath = val; break;
+        case 'u':
+            opt->ratioCount = parse_list(val, opt->ratios, NULL, 0);
+            if (opt->ratioCount <= 0) return -1;
+            break;
+        case 's':
+            opt->simd = find_key(val, strlen(val), g_simdNames, SIMD_COUNT);
+            if (opt->simd < 0) { printf("Чָ: %s\n", val); return -1; }
+            break;
+        case 'v':
+            if (strcmp(val, "counted") == 0) opt->variant = VARIANT_COUNTED;
+            else if (strcmp(val, "fast") == 0) opt->variant = VARIANT_FAST;
+            else if (strcmp(val, "both") == 0) opt->variant = VARIANT_BOTH;
+            else { printf("Ч汾: %s\n", val); return -1; }
+            break;
+        default:
+            printf("Ч: %s\n", flag);
+            usage();
+            return -1;
+        }
+    }
+    if (opt->sizeCount <= 0 || opt->distCount <= 0 || opt->algoCount <= 0) return -1;
+    if (opt->warmup < 0) opt->warmup = 0;
+    if (opt->reps < 1) opt->reps = 1;
+    return 0;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// ͳ samples (ᱻԭ)
+static BenchStats calc_stats(double samples[], int reps, int n) {
+    BenchStats st;
+    memset(&st, 0, sizeof(st));
+    qsort(samples, reps, sizeof(double), cmp_double);
+
+    st.minMs = samples[0];
+    st.medianMs = (reps % 2) ? samples[reps / 2] : (samples[reps / 2 - 1] + samples[reps / 2]) / 2.0;
+    int p95 = (int)ceil(0.95 * reps) - 1;   // ȷ
+    st.p95Ms = samples[p95 < 0 ? 0 : p95];
+
+    double sum = 0.0;
+    for (int i = 0; i < reps; i++) sum += samples[i];
+    st.meanMs = sum / reps;
+    double var = 0.0;
+    for (int i = 0; i < reps; i++) var += (samples[i] - st.meanMs) * (samples[i] - st.meanMs);
+    st.stddevMs = reps > 1 ? sqrt(var / (reps - 1)) : 0.0;
+
+    st.elemsPerSec = st.medianMs > 0 ? n / (st.medianMs / 1000.0) : 0.0;
+    return st;
+}
+
+static int is_sorted(const int arr[], int n) {
+    for (int i = 1; i < n; i++) if (arr[i - 1] > arr[i]) return 0;
+    return 1;
+}
+
+static void write_csv_header(FILE* fp) {
+    fseek(fp, 0, SEEK_END);
+    if (ftell(fp) == 0) {
+        fprintf(fp, "Algorithm,Distribution,DataSize,Warmup,Reps,Min(ms),Median(ms),P95(ms),Mean(ms),Stddev(ms),ElemsPerSec,Comparisons,Moves,InstrumentTax(%%),"
+            "Cycles,Instructions,IPC,BranchMisses,L1DMisses,LLCMisses,DTLBMisses,PageFaults\n");
+    }
+}
+
+// ûӲȱҳʱ CSV Ӧ
+#define CSV_HW_EMPTY ",,,,,,,,"
+
+// ۼƵȱҳ (ȱҳ״δ·ڴ漴һ)
+static long long page_faults(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return (long long)pmc.PageFaultCount;
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    return (long long)ru.ru_minflt + ru.ru_majflt;
+#endif
+}
+
+// һ㷨Ԥ + ظʱsp һеͳƣok ؽǷ
+// hw  NULL ʱÿμʱͬʱɼӲhwOut ظεƽֵ
+static BenchStats measure(const BenchOptions* opt, int algo, int options, const int input[], int work[], int n,
+    double samples[], SortPerformance* sp, int* ok, SortHwSession* hw, SortHwCounters* hwOut, SortArena* arena) {
+    SortContext ctx;
+    sort_context_init(&ctx);
+    ctx.options = options;
+    ctx.threads = opt->threads;
+    ctx.arena = arena;
+    // ÿ input Ƶ work input ֲ
+    SortBuffer src = { (void*)input, n, sizeof(int) };
+    // ɼʱиƣֻ
+    SortBuffer dst = { work, n, sizeof(int) };
+    SortContext hwCtx = ctx;
+    hwCtx.options |= SORT_OPT_NO_COPY;
+
+    for (int w = 0; w < opt->warmup; w++) sort_buffer(&ctx, algo, &src, work);
+
+    *ok = 1;
+    long long faults = page_faults();
+    long long sum[6] = { 0 };
+    int valid = hw ? -1 : 0;
+    for (int r = 0; r < opt->reps; r++) {
+        if (hw) {
+            SortHwCounters one;
+            memcpy(work, input, (size_t)n * sizeof(int));
+            sort_hw_start(hw);
+            sort_buffer(&hwCtx, algo, &dst, NULL);
+            sort_hw_stop(hw, &one);
+            ctx.stats = hwCtx.stats;
+            valid &= one.valid;
+            sum[0] += one.cycles; sum[1] += one.instructions; sum[2] += one.branchMisses;
+            sum[3] += one.l1dMisses; sum[4] += one.llcMisses; sum[5] += one.dtlbMisses;
+        }
+        else {
+            sort_buffer(&ctx, algo, &src, work);
+        }
+        samples[r] = ctx.stats.timeCost;
+        if (r == 0 && !is_sorted(work, n)) *ok = 0;
+    }
+    if (hw) {
+        hwOut->valid = valid;
+        hwOut->cycles = sum[0] / opt->reps;
+        hwOut->instructions = sum[1] / opt->reps;
+        hwOut->branchMisses = sum[2] / opt->reps;
+        hwOut->l1dMisses = sum[3] / opt->reps;
+        hwOut->llcMisses = sum[4] / opt->reps;
+        hwOut->dtlbMisses = sum[5] / opt->reps;
+    }
+    faults = page_faults() - faults;
+    *sp = ctx.stats;
+    BenchStats st = calc_stats(samples, opt->reps, n);
+    st.pageFaults = (double)faults / opt->reps;
+    return st;
+}
+
+// Ӳһʱ n/a ()  (CSV)
+static void format_hw(char* buf, size_t size, const SortHwCounters* hw, int bit, long long value, int csv) {
+    if (!(hw->valid & bit)) snprintf(buf, size, "%s", csv ? "" : "n/a");
+    else if (csv) snprintf(buf, size, "%lld", value);
+    else snprintf(buf, size, "%.4g", (double)value);
+}
+
+static void format_ipc(char* buf, size_t size, const SortHwCounters* hw, int csv) {
+    int need = SORT_HW_CYCLES | SORT_HW_INSTRUCTIONS;
+    if ((hw->valid & need) == need && hw->cycles > 0) snprintf(buf, size, "%.3f", (double)hw->instructions / hw->cycles);
+    else snprintf(buf, size, "%s", csv ? "" : "n/a");
+}
+
+// һнtax Ϊ NULL ʾûпɶԱȵ㿪棬hw Ϊ NULL ʾδɼӲ
+static void report(FILE* csv, const BenchOptions* opt, const char* dist, int n,
+    const SortPerformance* sp, const BenchStats* st, const double* tax, int ok, const SortHwCounters* hw) {
+    char taxStr[16] = "-";
+    if (tax) snprintf(taxStr, sizeof(taxStr), "%+.1f%%", *tax);
+
+    printf("%-28s %-8s %10d %12.4f %12.4f %12.4f %12.4f %10.2f %14lld %14lld %8s %10.1f%s\n",
+        sp->algorithm, dist, n, st->minMs, st->medianMs, st->p95Ms, st->stddevMs,
+        st->elemsPerSec / 1e6, sp->compareCount, sp->moveCount, taxStr, st->pageFaults, ok ? "" : "  [δ!]");
+
+    // ӲһУcyc , ins ָ, br ֧Ԥʧ, l1d/llc/tlb δ
+    char f[7][32];
+    if (hw) {
+        format_hw(f[0], sizeof(f[0]), hw, SORT_HW_CYCLES, hw->cycles, 0);
+        format_hw(f[1], sizeof(f[1]), hw, SORT_HW_INSTRUCTIONS, hw->instructions, 0);
+        format_ipc(f[2], sizeof(f[2]), hw, 0);
+        format_hw(f[3], sizeof(f[3]), hw, SORT_HW_BRANCH_MISSES, hw->branchMisses, 0);
+        format_hw(f[4], sizeof(f[4]), hw, SORT_HW_L1D_MISSES, hw->l1dMisses, 0);
+        format_hw(f[5], sizeof(f[5]), hw, SORT_HW_LLC_MISSES, hw->llcMisses, 0);
+        format_hw(f[6], sizeof(f[6]), hw, SORT_HW_DTLB_MISSES, hw->dtlbMisses, 0);
+        printf("  %-20s cyc %s  ins %s  IPC %s  br %s  l1d %s  llc %s  tlb %s\n",
+            "", f[0], f[1], f[2], f[3], f[4], f[5], f[6]);
+    }
+
+    if (csv) {
+        fprintf(csv, "%s,%s,%d,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.0f,%lld,%lld,",
+            sp->algorithm, dist, n, opt->warmup, opt->reps,
+            st->minMs, st->medianMs, st->p95Ms, st->meanMs, st->stddevMs,
+            st->elemsPerSec, sp->compareCount, sp->moveCount);
+        if (tax) fprintf(csv, "%.2f", *tax);
+        if (hw) {
+            format_hw(f[0], sizeof(f[0]), hw, SORT_HW_CYCLES, hw->cycles, 1);
+            format_hw(f[1], sizeof(f[1]), hw, SORT_HW_INSTRUCTIONS, hw->instructions, 1);
+            format_ipc(f[2], sizeof(f[2]), hw, 1);
+            format_hw(f[3], sizeof(f[3]), hw, SORT_HW_BRANCH_MISSES, hw->branchMisses, 1);
+            format_hw(f[4], sizeof(f[4]), hw, SORT_HW_L1D_MISSES, hw->l1dMisses, 1);
+            format_hw(f[5], sizeof(f[5]), hw, SORT_HW_LLC_MISSES, hw->llcMisses, 1);
+            format_hw(f[6], sizeof(f[6]), hw, SORT_HW_DTLB_MISSES, hw->dtlbMisses, 1);
+            fprintf(csv, ",%s,%s,%s,%s,%s,%s,%s", f[0], f[1], f[2], f[3], f[4], f[5], f[6]);
+        }
+        else {
+            fprintf(csv, ",,,,,,,");
+        }
+        fprintf(csv, ",%.1f\n", st->pageFaults);
+        fflush(csv);
+    }
+}
+
+// ׷ӵʷ⣬еһζԱ
+static void track(BenchTracker* t, const char* algorithm, const char* dist, int n,
+    const BenchStats* st, const double samples[], int reps) {
+    if (t->history) bench_history_append(t->history, &t->fp, algorithm, dist, n, t->threads, st, samples, reps);
+    if (!t->hasBaseline) return;
+
+    const BenchRecord* base = bench_history_find(&t->baseline, algorithm, dist, n, t->threads, t->fp.cpu);
+    if (!base) {
+        printf("  %-20s ûͬһ CPU ϵĶӦ\n", "");
+        return;
+    }
+    BenchCompare cmp;
+    bench_compare(base, samples, reps, st->medianMs, t->threshold, BENCH_ALPHA, &cmp);
+    t->compared++;
+    if (cmp.verdict > 0) t->regressions++;
+    if (cmp.verdict < 0) t->improvements++;
+    char pText[32];
+    if (cmp.tested) snprintf(pText, sizeof(pText), "p=%.4f", cmp.pValue);
+    else snprintf(pText, sizeof(pText), "̫δ");
+    printf("  %-20s %s%s λ %.4f -> %.4f ms  %+.1f%%  %s%s%s\n", "",
+        base->label[0] ? " " : "", base->label, base->medianMs, st->medianMs, cmp.change, pText,
+        cmp.verdict > 0 ? "  [!]" : cmp.verdict < 0 ? "  [Ľ]" : "",
+        strcmp(base->compiler, t->fp.compiler) != 0 ? "  (ͬ)" : "");
+}
+
+// ʽƽļǷ (ļܱڴ)
+static int is_sorted_file(const char* path, long long* count) {
+    FILE* fp = open_file(path, "rb");
+    if (!fp) return 0;
+    SortBinHeader h;
+    int ok = fread(&h, sizeof(h), 1, fp) == 1 && h.magic == SORT_BIN_MAGIC;
+    long long seen = 0;
+    int prev = 0;
+    static int buf[1 << 16];
+    size_t got;
+    while (ok && (got = fread(buf, sizeof(int), 1 << 16, fp)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            if (seen > 0 && prev > buf[i]) ok = 0;
+            prev = buf[i];
+            seen++;
+        }
+    }
+    fclose(fp);
+    *count = seen;
+    return ok && seen == (long long)h.count;
+}
+
+static int run_external(const BenchOptions* opt, FILE* csv) {
+    char outPath[1024];
+    snprintf(outPath, sizeof(outPath), "%s.sorted", opt->externalPath);
+    ExternalSortOptions eo;
+    external_sort_options_init(&eo);
+    if (opt->memoryMb > 0) eo.memoryBudget = (long long)opt->memoryMb << 20;
+    if (opt->fanIn > 0) eo.fanIn = opt->fanIn;
+    eo.tempDir = opt->tempDir;
+
+    ExternalSortStats es;
+    if (external_sort_file(opt->externalPath, outPath, &eo, &es) != 0) {
+        printf("ⲿ %s ʧ\n", opt->externalPath);
+        return 2;
+    }
+    long long count;
+    int ok = is_sorted_file(outPath, &count) && count == es.elements;
+    printf("ⲿ %s -> %s%s\n", opt->externalPath, outPath, ok ? "" : "  [δ!]");
+    printf("  Ԫ %lld,  %d, ϲ %d, Ƚ %lld, дԪ %lld\n",
+        es.elements, es.runs, es.stats.passes, es.stats.compareCount, es.stats.moveCount);
+    printf("   %.1f MB, д %.1f MB\n", es.bytesRead / 1048576.0, es.bytesWritten / 1048576.0);
+    printf("  ֶ %.1f ms ( %.1f ms), ϲ %.1f ms, ܼ %.1f ms\n",
+        es.runMs, es.sortMs, es.mergeMs, es.stats.timeCost);
+    if (csv) {
+        fprintf(csv, "%s,%s,%lld,0,1,%.6f,%.6f,%.6f,%.6f,0,%.0f,%lld,%lld," CSV_HW_EMPTY "\n",
+            es.stats.algorithm, opt->externalPath, es.elements, es.stats.timeCost, es.stats.timeCost,
+            es.stats.timeCost, es.stats.timeCost, es.stats.timeCost > 0 ? es.elements / (es.stats.timeCost / 1000.0) : 0.0,
+            es.stats.compareCount, es.stats.moveCount);
+    }
+    return ok ? 0 : 1;
+}
+
+// n ֵÿ ratio βѯһ (λ +  ONLINE_RANGE Ԫ)
+// Ϊԭ׷ӵĩβѯʱ merge_sort
+#define ONLINE_RANGE 100
+
+// ѯʼ (ʹͬ)
+static long long online_pick(unsigned long long* rng, long long size) {
+    *rng = *rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (long long)((*rng >> 33) % (unsigned long long)size);
+}
+
+// ӦУ׼Чдļ (SORT_TUNING_FILE ָʱ´Զ)
+static int run_calibrate(const BenchOptions* opt) {
+    int maxN = 0;
+    for (int i = 0; i < opt->sizeCount; i++) {
+        if (opt->sizes[i] > maxN) maxN = opt->sizes[i];
+    }
+    printf("У׼Ӧ, ģ %d ...\n", maxN);
+    double start = get_time_ms();
+    SortTuning t;
+    if (sort_calibrate(maxN, opt->calibratePath, &t) != 0) {
+        printf("У׼ʧܻ޷д %s\n", opt->calibratePath);
+        return 2;
+    }
+    printf(" (%.1f ), ѱ浽 %s\n", (get_time_ms() - start) / 1000.0, opt->calibratePath);
+    printf("  TimSort      ƶ <= %.4f * n\n", t.runRatio);
+    printf("       ֵ <= %.2f * n\n", t.countRatio);
+    printf("       n >= %d, ظ < %.4f\n", t.radixMinN, t.duplicateRatio);
+    printf("   (%s)  n >= %d\n", t.parallelAlgo == SORT_PARALLEL_QUICK ? "quick" : "merge", t.parallelMinN);
+    printf("  (ֵΪ 0 ʾùر)\n");
+    return 0;
+}
+
+static int run_online(const BenchOptions* opt, FILE* csv) {
+    printf("%-10s %-8s %10s %10s %14s %16s %10s\n", "Ins/Query", "Dist", "Size", "Queries", "SortTree(ms)", "Append+Sort(ms)", "Speedup");
+    printf("------------------------------------------------------------------------------------\n");
+    int failures = 0;
+    for (int s = 0; s < opt->sizeCount; s++) {
+        int n = opt->sizes[s];
+        const BenchDist* dist = &g_dists[opt->dists[0]];
+        int* input = (int*)malloc((size_t)n * sizeof(int));
+        int* arr = (int*)malloc((size_t)n * sizeof(int));
+        int* range = (int*)malloc(ONLINE_RANGE * sizeof(int));
+        if (!input || !arr || !range) {
+            free(input); free(arr); free(range);
+            return 2;
+        }
+        generate_data_ex(input, n, dist->type, opt->seed, 0, 0);
+
+        for (int r = 0; r < opt->ratioCount; r++) {
+            int ratio = opt->ratios[r];
+            int queries = 0;
+            unsigned long long rng = opt->seed;
+            long long sumTree = 0, sumBase = 0;
+
+            double start = get_time_ms();
+            SortTree* tree = sort_tree_create();
+            if (!tree) return 2;
+            for (int i = 0; i < n; i++) {
+                sort_tree_insert(tree, input[i]);
+                if ((i + 1) % ratio != 0) continue;
+                long long size = i + 1;
+                int median;
+                sort_tree_select(tree, size / 2, &median);
+                int got = sort_tree_copy(tree, online_pick(&rng, size), range, ONLINE_RANGE);
+                long long sum = median;
+                for (int k = 0; k < got; k++) sum += range[k];
+                sumTree += sum;
+                queries++;
+            }
+            sort_tree_destroy(tree);
+            double treeMs = get_time_ms() - start;
+
+            rng = opt->seed;
+            start = get_time_ms();
+            for (int i = 0; i < n; i++) {
+                arr[i] = input[i];
+                if ((i + 1) % ratio != 0) continue;
+                long long size = i + 1;
+                merge_sort_fast(arr, i + 1);
+                long long from = online_pick(&rng, size);
+                long long to = from + ONLINE_RANGE < size ? from + ONLINE_RANGE : size;
+                long long sum = arr[size / 2];
+                for (long long k = from; k < to; k++) sum += arr[k];
+                sumBase += sum;
+            }
+            double baseMs = get_time_ms() - start;
+
+            int ok = sumTree == sumBase;
+            if (!ok) failures++;
+            printf("%-10d %-8s %10d %10d %14.2f %16.2f %9.1fx%s\n", ratio, dist->key, n, queries, treeMs, baseMs,
+                treeMs > 0 ? baseMs / treeMs : 0.0, ok ? "" : "  [һ!]");
+            if (csv) {
+                fprintf(csv, "Sort Tree (ins/query=%d),%s,%d,0,1,%.6f,%.6f,%.6f,%.6f,0,%.0f,0,0," CSV_HW_EMPTY "\n",
+                    ratio, dist->key, n, treeMs, treeMs, treeMs, treeMs, treeMs > 0 ? n / (treeMs / 1000.0) : 0.0);
+                fprintf(csv, "Append+Merge Sort (ins/query=%d),%s,%d,0,1,%.6f,%.6f,%.6f,%.6f,0,%.0f,0,0," CSV_HW_EMPTY "\n",
+                    ratio, dist->key, n, baseMs, baseMs, baseMs, baseMs, baseMs > 0 ? n / (baseMs / 1000.0) : 0.0);
+            }
+        }
+        free(input);
+        free(arr);
+        free(range);
+    }
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt;
+    if (parse_options(argc, argv, &opt) != 0) return 2;
+
+    if (opt.cpu >= 0 && !pin_cpu(opt.cpu)) {
+        printf(": ޷󶨵 CPU %d\n", opt.cpu);
+    }
+
+    FILE* csv = NULL;
+    if (opt.csvPath) {
+        csv = open_file(opt.csvPath, "a");
+        if (!csv) {
+            printf("޷дļ %s\n", opt.csvPath);
+            return 2;
+        }
+        write_csv_header(csv);
+    }
+
+    if (opt.calibratePath) {
+        if (csv) fclose(csv);
+        return run_calibrate(&opt);
+    }
+
+    if (opt.externalPath || opt.ratioCount > 0) {
+        int rc = opt.externalPath ? run_external(&opt, csv) : run_online(&opt, csv);
+        if (csv) fclose(csv);
+        return rc;
+    }
+
+    // ȶٴʷ⣺߿ͬһļ
+    BenchTracker tracker;
+    memset(&tracker, 0, sizeof(tracker));
+    bench_fingerprint(&tracker.fp, opt.label);
+    tracker.threads = opt.threads > 0 ? opt.threads : tracker.fp.hwThreads;
+    tracker.threshold = opt.threshold;
+    if (opt.baselinePath) {
+        if (bench_history_load(opt.baselinePath, &tracker.baseline) != 0) {
+            printf("޷ȡ %s\n", opt.baselinePath);
+            if (csv) fclose(csv);
+            return 2;
+        }
+        tracker.hasBaseline = 1;
+    }
+    if (opt.historyPath) {
+        tracker.history = open_file(opt.historyPath, "a");
+        if (!tracker.history) {
+            printf("޷дļ %s\n", opt.historyPath);
+            bench_history_free(&tracker.baseline);
+            if (csv) fclose(csv);
+            return 2;
+        }
+        bench_history_write_header(tracker.history);
+    }
+
+    // 㿪һ룬Ҫдʷ
+    double* samples = (double*)malloc(2 * (size_t)opt.reps * sizeof(double));
+    if (!samples) return 2;
+    double* samplesC = samples;
+    double* samplesF = samples + opt.reps;
+    int failures = 0;
+
+    SortHwSession* hw = NULL;
+    if (opt.hwCounters) {
+        hw = sort_hw_open();
+        if (!hw || sort_hw_valid(hw) == 0) {
+            printf(": Ӳ (Ȩ޻)ֻʱ\n");
+            sort_hw_close(hw);
+            hw = NULL;
+        }
+    }
+
+    // ڴشӿտʼԤȵĵһ
+    SortArena* arena = NULL;
+    if (opt.arena > 0) {
+        arena = sort_arena_create(0, opt.arena >= 2 ? SORT_ARENA_HUGE_PAGES | SORT_ARENA_PREFAULT : 0);
+        if (!arena) printf(": ڴشʧܣΪÿ malloc\n");
+    }
+
+    int simd = opt.simd >= 0 ? sort_simd_set_level(opt.simd) : sort_simd_level();
+    printf("Ԥ %d , ʱ %d , ߳ %d,  %s,  %llu\n",
+        opt.warmup, opt.reps, opt.threads, g_simdNames[simd], opt.seed);
+    printf("%s | %s | %s | %s\n", tracker.fp.cpu, tracker.fp.compiler, tracker.fp.flags, tracker.fp.platform);
+    tracker.fp.seed = opt.seed;
+    tracker.fp.warmup = opt.warmup;
+    tracker.fp.reps = opt.reps;
+    snprintf(tracker.fp.simd, sizeof(tracker.fp.simd), "%s", g_simdNames[simd]);
+    printf("%-28s %-8s %10s %12s %12s %12s %12s %10s %14s %14s %8s %10s\n",
+        "Algorithm", "Dist", "Size", "Min(ms)", "Median(ms)", "P95(ms)", "Stddev(ms)",
+        "Melem/s", "Compares", "Moves", "Tax", "Faults/run");
+    printf("-------------------------------------------------------------------------------------------------------------------------------------------------------------\n");
+
+    for (int s = 0; s < opt.sizeCount; s++) {
+        int n = opt.sizes[s];
+        int* input = (int*)malloc((size_t)n * sizeof(int));
+        int* work = (int*)malloc((size_t)n * sizeof(int));
+        if (!input || !work) {
+            printf("󣺹ģ %d ڴʧ\n", n);
+            free(input); free(work);
+            failures++;
+            continue;
+        }
+        // Ԥȴȫҳ棬ּʱȱҳ
+        memset(work, 0, (size_t)n * sizeof(int));
+
+        for (int d = 0; d < opt.distCount; d++) {
+            const BenchDist* dist = &g_dists[opt.dists[d]];
+            generate_data_ex(input, n, dist->type, opt.seed, 0, 0);
+
+            for (int a = 0; a < opt.algoCount; a++) {
+                const BenchAlgo* algo = &g_algos[opt.algos[a]];
+                if (opt.cpu >= 0) pin_cpu(is_parallel(algo->algo) ? -1 : opt.cpu);
+                SortPerformance spC, spF;
+                SortHwCounters hwC, hwF;
+                BenchStats stC, stF;
+                int okC = 1, okF = 1;
+                memset(&spC, 0, sizeof(spC));
+                memset(&spF, 0, sizeof(spF));
+                memset(&stC, 0, sizeof(stC));
+                memset(&stF, 0, sizeof(stF));
+
+                if (opt.variant & VARIANT_COUNTED) stC = measure(&opt, algo->algo, 0, input, work, n, samplesC, &spC, &okC, hw, &hwC, arena);
+                if (opt.variant & VARIANT_FAST) stF = measure(&opt, algo->algo, SORT_OPT_FAST, input, work, n, samplesF, &spF, &okF, hw, &hwF, arena);
+
+                // ׮λʱ㿪
+                double tax = 0.0;
+                int hasTax = opt.variant == VARIANT_BOTH && stF.medianMs > 0;
+                if (hasTax) tax = (stC.medianMs / stF.medianMs - 1.0) * 100.0;
+
+                if (opt.variant & VARIANT_COUNTED) {
+                    report(csv, &opt, dist->key, n, &spC, &stC, hasTax ? &tax : NULL, okC, hw ? &hwC : NULL);
+                    if (okC) track(&tracker, spC.algorithm, dist->key, n, &stC, samplesC, opt.reps);
+                }
+                if (opt.variant & VARIANT_FAST) {
+                    report(csv, &opt, dist->key, n, &spF, &stF, NULL, okF, hw ? &hwF : NULL);
+                    if (okF) track(&tracker, spF.algorithm, dist->key, n, &stF, samplesF, opt.reps);
+                }
+                if (!okC || !okF) failures++;
+            }
+        }
+        free(input);
+        free(work);
+    }
+
+    free(samples);
+    sort_hw_close(hw);
+    if (arena) {
+        static const char* hugeNames[] = { "", "ʽҳ", "͸ҳ" };
+        SortArenaInfo info;
+        sort_arena_info(arena, &info);
+        printf("ڴ:  %.1f MB,  %.1f MB, ˻ malloc %lld , ӳ %lld , ҳ %s\n",
+            info.capacity / 1048576.0, info.highWater / 1048576.0, info.fallbacks, info.grows, hugeNames[info.hugePages]);
+        sort_arena_destroy(arena);
+    }
+    if (csv) {
+        fclose(csv);
+        printf("׷ %s\n", opt.csvPath);
+    }
+    if (tracker.history) {
+        fclose(tracker.history);
+        printf("ʷ׷ %s\n", opt.historyPath);
+    }
+    if (tracker.hasBaseline) {
+        printf("߶Ա: %d ,  %d , Ľ %d  (ֵ %.1f%%,  %.2f)\n",
+            tracker.compared, tracker.regressions, tracker.improvements, opt.threshold, BENCH_ALPHA);
+        bench_history_free(&tracker.baseline);
+    }
+    if (failures) return 1;
+    return tracker.regressions ? 3 : 0;
+}
@@ -0,0 +1,410 @@
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif
+
+#include "sort_bench_history.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <unistd.h>
+#endif
+
+#define HISTORY_MIN_SAMPLES 5   // һڸôʱ (5  5 ʱ p ֵСΪ 1/252)
+#define HISTORY_EXACT_MAX 400   // ֵ֮޲ʱ U ľȷֲ
+
+// 1. ָ
+
+// CSV ֶﲻַָܳ뻻
+static void copy_field(char* dst, size_t size, const char* src) {
+    size_t i = 0;
+    for (; src && src[i] && i + 1 < size; i++) {
+        char c = src[i];
+        dst[i] = (c == ',' || c == '"' || c == '\n' || c == '\r') ? ' ' : c;
+    }
+    dst[i] = '\0';
+}
+
+static void detect_cpu(char* buf, size_t size) {
+    copy_field(buf, size, "unknown");
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int r[12];
+    __cpuid(r, 0x80000000);
+    if ((unsigned int)r[0] < 0x80000004) return;
+    __cpuid(r, 0x80000002);
+    __cpuid(r + 4, 0x80000003);
+    __cpuid(r + 8, 0x80000004);
+    char brand[49];
+    memcpy(brand, r, 48);
+    brand[48] = '\0';
+    const char* p = brand;
+    while (*p == ' ') p++;
+    copy_field(buf, size, p);
+#elif defined(__linux__)
+    FILE* fp = fopen("/proc/cpuinfo", "r");
+    if (!fp) return;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        // x86 Ϊ model name ARM ںֻ Hardware / Model
+        if (strncmp(line, "model name", 10) == 0 || strncmp(line, "Hardware", 8) == 0 || strncmp(line, "Model", 5) == 0) {
+            char* p = strchr(line, ':');
+            if (!p) continue;
+            p++;
+            while (*p == ' ' || *p == '\t') p++;
+            p[strcspn(p, "\r\n")] = '\0';
+            if (*p) copy_field(buf, size, p);
+            break;
+        }
+    }
+    fclose(fp);
+#endif
+}
+
+static void detect_flags(char* buf, size_t size) {
+#ifdef SORT_BENCH_FLAGS
+    copy_field(buf, size, SORT_BENCH_FLAGS);
+#else
+    buf[0] = '\0';
+    const char* flags[8];
+    int count = 0;
+#if defined(_DEBUG)
+    flags[count++] = "Debug";
+#elif defined(__OPTIMIZE_SIZE__)
+    flags[count++] = "-Os";
+#elif defined(__OPTIMIZE__) || (defined(_MSC_VER) && !defined(_DEBUG))
+    flags[count++] = "Opt";
+#else
+    flags[count++] = "-O0";
+#endif
+#ifdef NDEBUG
+    flags[count++] = "NDEBUG";
+#endif
+#ifdef __SSE4_1__
+    flags[count++] = "SSE4.1";
+#endif
+#ifdef __AVX2__
+    flags[count++] = "AVX2";
+#endif
+#ifdef __AVX512F__
+    flags[count++] = "AVX512F";
+#endif
+    size_t len = 0;
+    for (int i = 0; i < count && len + 1 < size; i++) {
+        len += (size_t)snprintf(buf + len, size - len, "%s%s", i ? " " : "", flags[i]);
+    }
+#endif
+}
+
+void bench_fingerprint(BenchFingerprint* fp, const char* label) {
+    memset(fp, 0, sizeof(*fp));
+    time_t now = time(NULL);
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    strftime(fp->time, sizeof(fp->time), "%Y-%m-%d %H:%M:%S", &tm);
+    copy_field(fp->label, sizeof(fp->label), label ? label : "");
+
+#if defined(__clang__)
+    snprintf(fp->compiler, sizeof(fp->compiler), "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+    snprintf(fp->compiler, sizeof(fp->compiler), "gcc %s", __VERSION__);
+#elif defined(_MSC_VER)
+    snprintf(fp->compiler, sizeof(fp->compiler), "msvc %d", _MSC_FULL_VER);
+#else
+    snprintf(fp->compiler, sizeof(fp->compiler), "unknown");
+#endif
+    copy_field(fp->compiler, sizeof(fp->compiler), fp->compiler);
+    detect_flags(fp->flags, sizeof(fp->flags));
+    detect_cpu(fp->cpu, sizeof(fp->cpu));
+
+#if defined(_WIN32) && defined(_WIN64)
+    snprintf(fp->platform, sizeof(fp->platform), "windows-x64");
+#elif defined(_WIN32)
+    snprintf(fp->platform, sizeof(fp->platform), "windows-x86");
+#elif defined(__linux__) && defined(__x86_64__)
+    snprintf(fp->platform, sizeof(fp->platform), "linux-x86_64");
+#elif defined(__linux__) && defined(__aarch64__)
+    snprintf(fp->platform, sizeof(fp->platform), "linux-aarch64");
+#else
+    snprintf(fp->platform, sizeof(fp->platform), "other");
+#endif
+
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    fp->hwThreads = (int)info.dwNumberOfProcessors;
+#else
+    fp->hwThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (fp->hwThreads < 1) fp->hwThreads = 1;
+}
+
+// 2. д
+
+void bench_history_write_header(FILE* fp) {
+    fseek(fp, 0, SEEK_END);
+    if (ftell(fp) == 0) {
+        fprintf(fp, "Time,Label,Compiler,Flags,CPU,Platform,HwThreads,Seed,Warmup,Reps,Simd,"
+            "Algorithm,Distribution,DataSize,Threads,Min(ms),Median(ms),P95(ms),Mean(ms),Stddev(ms),Samples(ms)\n");
+    }
+}
+
+void bench_history_append(FILE* fp, const BenchFingerprint* f, const char* algorithm, const char* dist,
+    int n, int threads, const BenchStats* st, const double samples[], int reps) {
+    fprintf(fp, "%s,%s,%s,%s,%s,%s,%d,%llu,%d,%d,%s,%s,%s,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,",
+        f->time, f->label, f->compiler, f->flags, f->cpu, f->platform, f->hwThreads,
+        f->seed, f->warmup, f->reps, f->simd,
+        algorithm, dist, n, threads, st->minMs, st->medianMs, st->p95Ms, st->meanMs, st->stddevMs);
+    // ȫԱʱȺͼ
+    for (int i = 0; i < reps; i++) fprintf(fp, "%s%.6f", i ? ";" : "", samples[i]);
+    fprintf(fp, "\n");
+    fflush(fp);
+}
+
+// 3. ȡ
+
+// һ (пܺܳ)ȥβУļ 0
+static int read_line(FILE* fp, char** buf, size_t* cap) {
+    size_t len = 0;
+    for (;;) {
+        if (*cap - len < 2) {
+            size_t size = *cap ? *cap * 2 : 1024;
+            char* p = (char*)realloc(*buf, size);
+            if (!p) return 0;
+            *buf = p;
+            *cap = size;
+        }
+        if (!fgets(*buf + len, (int)(*cap - len), fp)) {
+            if (len == 0) return 0;
+            break;
+        }
+        len += strlen(*buf + len);
+        if (len > 0 && (*buf)[len - 1] == '\n') break;
+    }
+    while (len > 0 && ((*buf)[len - 1] == '\n' || (*buf)[len - 1] == '\r')) (*buf)[--len] = '\0';
+    return 1;
+}
+
+// ԭзֶ֣
+static int split_fields(char* line, char* fields[], int max) {
+    int count = 0;
+    char* p = line;
+    while (count < max) {
+        fields[count++] = p;
+        char* comma = strchr(p, ',');
+        if (!comma) break;
+        *comma = '\0';
+        p = comma + 1;
+    }
+    return count;
+}
+
+// ͷλУе˳仯ӰļĶȡ
+enum { COL_ALGO, COL_DIST, COL_SIZE, COL_THREADS, COL_CPU, COL_COMPILER, COL_LABEL, COL_MEDIAN, COL_SAMPLES, COL_COUNT };
+static const char* g_columns[COL_COUNT] = {
+    "Algorithm", "Distribution", "DataSize", "Threads", "CPU", "Compiler", "Label", "Median(ms)", "Samples(ms)",
+};
+
+#define HISTORY_MAX_FIELDS 64
+
+static int parse_samples(const char* text, double** out) {
+    int count = 0, cap = 0;
+    double* values = NULL;
+    const char* p = text;
+    while (*p) {
+        char* end;
+        double v = strtod(p, &end);
+        if (end == p) break;
+        if (count == cap) {
+            cap = cap ? cap * 2 : 16;
+            double* grown = (double*)realloc(values, (size_t)cap * sizeof(double));
+            if (!grown) break;
+            values = grown;
+        }
+        values[count++] = v;
+        p = *end == ';' ? end + 1 : end;
+    }
+    *out = values;
+    return count;
+}
+
+int bench_history_load(const char* path, BenchHistory* h) {
+    memset(h, 0, sizeof(*h));
+    FILE* fp = NULL;
+#ifdef _WIN32
+    if (fopen_s(&fp, path, "r") != 0) fp = NULL;
+#else
+    fp = fopen(path, "r");
+#endif
+    if (!fp) return -1;
+
+    char* line = NULL;
+    size_t cap = 0;
+    char* fields[HISTORY_MAX_FIELDS];
+    int col[COL_COUNT];
+    int haveHeader = 0;
+    while (read_line(fp, &line, &cap)) {
+        int count = split_fields(line, fields, HISTORY_MAX_FIELDS);
+        if (!haveHeader) {
+            for (int c = 0; c < COL_COUNT; c++) {
+                col[c] = -1;
+                for (int i = 0; i < count; i++) {
+                    if (strcmp(fields[i], g_columns[c]) == 0) col[c] = i;
+                }
+            }
+            haveHeader = 1;
+            continue;
+        }
+        int missing = 0;
+        for (int c = 0; c < COL_COUNT; c++) {
+            if (col[c] < 0 || col[c] >= count) missing = 1;
+        }
+        if (missing) continue;
+
+        if (h->count == h->capacity) {
+            int size = h->capacity ? h->capacity * 2 : 64;
+            BenchRecord* items = (BenchRecord*)realloc(h->items, (size_t)size * sizeof(BenchRecord));
+            if (!items) break;
+            h->items = items;
+            h->capacity = size;
+        }
+        BenchRecord* r = &h->items[h->count];
+        memset(r, 0, sizeof(*r));
+        copy_field(r->algorithm, sizeof(r->algorithm), fields[col[COL_ALGO]]);
+        copy_field(r->dist, sizeof(r->dist), fields[col[COL_DIST]]);
+        copy_field(r->cpu, sizeof(r->cpu), fields[col[COL_CPU]]);
+        copy_field(r->compiler, sizeof(r->compiler), fields[col[COL_COMPILER]]);
+        copy_field(r->label, sizeof(r->label), fields[col[COL_LABEL]]);
+        r->n = atoi(fields[col[COL_SIZE]]);
+        r->threads = atoi(fields[col[COL_THREADS]]);
+        r->medianMs = atof(fields[col[COL_MEDIAN]]);
+        r->count = parse_samples(fields[col[COL_SAMPLES]], &r->samples);
+        h->count++;
+    }
+    free(line);
+    fclose(fp);
+    return 0;
+}
+
+void bench_history_free(BenchHistory* h) {
+    for (int i = 0; i < h->count; i++) free(h->items[i].samples);
+    free(h->items);
+    memset(h, 0, sizeof(*h));
+}
+
+const BenchRecord* bench_history_find(const BenchHistory* h, const char* algorithm, const char* dist,
+    int n, int threads, const char* cpu) {
+    // ļʱ׷ӣӺǰҵĵһһ
+    for (int i = h->count - 1; i >= 0; i--) {
+        const BenchRecord* r = &h->items[i];
+        if (r->n == n && r->threads == threads && strcmp(r->algorithm, algorithm) == 0
+            && strcmp(r->dist, dist) == 0 && strcmp(r->cpu, cpu) == 0) return r;
+    }
+    return NULL;
+}
+
+// 4. Ա
+
+typedef struct {
+    double value;
+    int fromNew;
+} RankItem;
+
+static int cmp_rank_item(const void* a, const void* b) {
+    double x = ((const RankItem*)a)->value, y = ((const RankItem*)b)->value;
+    return (x > y) - (x < y);
+}
+
+// U ľȷֲ޲ʱ U = u  prod_{i=1..k} (1 - q^(m+i)) / (1 - q^i)  q^u ϵ
+// ϵ֮Ϊ C(m+k, k) P(U >= u)ڴ治㷵 -1
+static double mann_whitney_exact(int m, int k, double u) {
+    int maxU = m * k;
+    double* c = (double*)calloc((size_t)(maxU + k + 1), sizeof(double));
+    if (!c) return -1.0;
+    c[0] = 1.0;
+    int deg = 0;
+    for (int i = 1; i <= k; i++) {
+        //  (1 - q^(m+i))Ӹߵԭظ
+        int s = m + i;
+        for (int j = deg + s; j >= s; j--) c[j] -= c[j - s];
+        //  (1 - q^i)ӵ͵ԭظ£̵ĴΪ deg + m
+        for (int j = i; j <= deg + m; j++) c[j] += c[j - i];
+        for (int j = deg + m + 1; j <= deg + s; j++) c[j] = 0.0;
+        deg += m;
+    }
+    double total = 0.0, tail = 0.0;
+    for (int j = 0; j <= maxU; j++) {
+        total += c[j];
+        if (j >= u) tail += c[j];
+    }
+    free(c);
+    return tail / total;
+}
+
+// C(m+k, k) ֻһˣp ֵܵ䵹
+static double mann_whitney_min_p(int m, int k) {
+    double ways = 1.0;
+    for (int i = 1; i <= k; i++) ways = ways * (m + i) / i;
+    return 1.0 / ways;
+}
+
+// Mann-Whitney U 飺 "ڻ" ĵ p ֵʱֲƫҳȺֵȼ t Ƚ
+// С޲ʱþȷֲ̬ (УУ)
+static double mann_whitney_greater(const double base[], int m, const double cur[], int k) {
+    int total = m + k;
+    RankItem* items = (RankItem*)malloc((size_t)total * sizeof(RankItem));
+    if (!items) return 1.0;
+    for (int i = 0; i < m; i++) { items[i].value = base[i]; items[i].fromNew = 0; }
+    for (int i = 0; i < k; i++) { items[m + i].value = cur[i]; items[m + i].fromNew = 1; }
+    qsort(items, total, sizeof(RankItem), cmp_rank_item);
+
+    double rankSum = 0.0, tieTerm = 0.0;
+    for (int i = 0; i < total;) {
+        int j = i;
+        while (j + 1 < total && items[j + 1].value == items[i].value) j++;
+        double rank = (i + j) / 2.0 + 1.0;   // ȡƽ
+        for (int t = i; t <= j; t++) if (items[t].fromNew) rankSum += rank;
+        double ties = j - i + 1;
+        tieTerm += ties * ties * ties - ties;
+        i = j + 1;
+    }
+    free(items);
+
+    double u = rankSum - k * (k + 1) / 2.0;
+    if (tieTerm == 0.0 && m * k <= HISTORY_EXACT_MAX) {
+        double p = mann_whitney_exact(m, k, u);
+        if (p >= 0.0) return p;
+    }
+    double mean = (double)m * k / 2.0;
+    double var = (double)m * k / 12.0 * ((total + 1) - tieTerm / ((double)total * (total - 1)));
+    if (var <= 0.0) return 1.0;
+    double z = (u - mean - 0.5) / sqrt(var);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+void bench_compare(const BenchRecord* base, const double samples[], int reps, double medianMs,
+    double threshold, double alpha, BenchCompare* out) {
+    memset(out, 0, sizeof(*out));
+    out->pValue = 1.0;
+    if (base->medianMs <= 0.0) return;
+    out->change = (medianMs / base->medianMs - 1.0) * 100.0;
+    if (base->count < HISTORY_MIN_SAMPLES || reps < HISTORY_MIN_SAMPLES
+        || mann_whitney_min_p(base->count, reps) >= alpha) return;
+    out->tested = 1;
+
+    // һε飬仯Զ½
+    out->pValue = mann_whitney_greater(base->samples, base->count, samples, reps);
+    if (out->change > threshold && out->pValue < alpha) {
+        out->verdict = 1;
+    }
+    else if (out->change < -threshold && mann_whitney_greater(samples, reps, base->samples, base->count) < alpha) {
+        out->verdict = -1;
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef SORT_BENCH_HISTORY_H
+#define SORT_BENCH_HISTORY_H
+
+// ׼ʷ (ֻ sort_bench DLL)
+// ÿμʱĽָͬ׷Ϊһ CSVԱģʽʷļȡͬһ
+// (㷨, ֲ, ģ, ߳, CPU) һΪߣȺͼжǷ
+
+#include <stdio.h>
+
+// ͳƽ ()
+typedef struct {
+    double minMs;
+    double medianMs;
+    double p95Ms;
+    double meanMs;
+    double stddevMs;
+    double elemsPerSec;   // λ
+    double pageFaults;    // ÿμʱƽȱҳ
+} BenchStats;
+
+// ָ뱾еĲ
+typedef struct {
+    char time[32];
+    char label[64];        // ߸ıǩ (ύ)Ϊ
+    char compiler[96];
+    char flags[96];        // ڿɼŻ/ָ꣬ SORT_BENCH_FLAGS ѡ
+    char cpu[96];
+    char platform[32];
+    int hwThreads;
+    unsigned long long seed;
+    int warmup;
+    int reps;
+    char simd[16];
+} BenchFingerprint;
+
+// ʷļеһ¼
+typedef struct {
+    char algorithm[48];
+    char dist[16];
+    int n;
+    int threads;
+    char cpu[96];
+    char compiler[96];
+    char label[64];
+    double medianMs;
+    double* samples;       // μʱ ()
+    int count;
+} BenchRecord;
+
+typedef struct {
+    BenchRecord* items;
+    int count;
+    int capacity;
+} BenchHistory;
+
+// ԱȽverdict Ϊ 1 ҳֵ-1 ҳֵ0 
+typedef struct {
+    double change;         // λԻߵı仯 (%)
+    double pValue;         //  p ֵ ()
+    int tested;            // 0 ʾ̫ (һ 5 Σ alpha ²)δ
+    int verdict;
+} BenchCompare;
+
+void bench_fingerprint(BenchFingerprint* fp, const char* label);
+
+// ׷һУļΪʱдͷ
+void bench_history_write_header(FILE* fp);
+void bench_history_append(FILE* fp, const BenchFingerprint* f, const char* algorithm, const char* dist,
+    int n, int threads, const BenchStats* st, const double samples[], int reps);
+
+// ȡʷļļڷ -1
+int bench_history_load(const char* path, BenchHistory* h);
+void bench_history_free(BenchHistory* h);
+// ͬһͬһ CPU һûз NULL
+const BenchRecord* bench_history_find(const BenchHistory* h, const char* algorithm, const char* dist,
+    int n, int threads, const char* cpu);
+
+// ߶Աȣthreshold Ϊλ (%)alpha Ϊˮƽ
+void bench_compare(const BenchRecord* base, const double samples[], int reps, double medianMs,
+    double threshold, double alpha, BenchCompare* out);
+
+#endif
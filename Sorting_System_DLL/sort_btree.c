@@ -0,0 +1,516 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// B+  (ظֵ)
+// Ҷǿ int 鲢ֻ˳ memcpy
+// ڲ¼ÿԪѡȡ/ζֻһҶ·
+// ڲ keys[i] ӽ i ½磺ӽ i ֮ǰԪضӽ i ֮ԪضС
+
+#define BT_LEAF 256              // Ҷ (1KB)
+#define BT_INNER 32              // ڲȳ
+#define BT_LEAF_MIN (BT_LEAF / 4)
+#define BT_INNER_MIN (BT_INNER / 4)
+#define BT_BUILD_LEAF (BT_LEAF * 7 / 8)   // ʱռ
+#define BT_BUILD_INNER (BT_INNER * 7 / 8)
+#define BT_BULK_RATIO 4          // 벻Ԫ 1/4 ʱ鲢ؽ
+
+typedef struct {
+    int leaf;
+    int count;               // ҶΪԪڲΪӽ
+} BtNode;
+
+typedef struct BtLeaf {
+    BtNode h;
+    struct BtLeaf* next;
+    int keys[BT_LEAF];
+} BtLeaf;
+
+typedef struct {
+    BtNode h;
+    int keys[BT_INNER];
+    long long sizes[BT_INNER];
+    BtNode* child[BT_INNER];
+} BtInner;
+
+struct SortTree {
+    BtNode* root;
+    long long size;
+};
+
+// 1. 
+static BtLeaf* leaf_new(void) {
+    BtLeaf* lf = (BtLeaf*)malloc(sizeof(BtLeaf));
+    if (!lf) return NULL;
+    lf->h.leaf = 1;
+    lf->h.count = 0;
+    lf->next = NULL;
+    return lf;
+}
+
+static BtInner* inner_new(void) {
+    BtInner* in = (BtInner*)malloc(sizeof(BtInner));
+    if (!in) return NULL;
+    in->h.leaf = 0;
+    in->h.count = 0;
+    return in;
+}
+
+static void node_free(BtNode* node) {
+    if (!node->leaf) {
+        BtInner* in = (BtInner*)node;
+        for (int i = 0; i < in->h.count; i++) node_free(in->child[i]);
+    }
+    free(node);
+}
+
+static int node_first_key(const BtNode* node) {
+    return node->leaf ? ((const BtLeaf*)node)->keys[0] : ((const BtInner*)node)->keys[0];
+}
+
+static long long node_size(const BtNode* node) {
+    if (node->leaf) return node->count;
+    const BtInner* in = (const BtInner*)node;
+    long long s = 0;
+    for (int i = 0; i < in->h.count; i++) s += in->sizes[i];
+    return s;
+}
+
+// һ >= v (inclusive ʱΪ > v) λ
+static int leaf_bound(const BtLeaf* lf, int v, int inclusive) {
+    int lo = 0, hi = lf->h.count;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (lf->keys[mid] < v || (inclusive && lf->keys[mid] == v)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// ܺ < v (inclusive ʱΪ <= v) һӽ
+static int inner_route(const BtInner* in, int v, int inclusive) {
+    int lo = 1, hi = in->h.count;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (in->keys[mid] < v || (inclusive && in->keys[mid] == v)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo - 1;
+}
+
+static void inner_insert_at(BtInner* in, int pos, BtNode* child, int key, long long size) {
+    int move = in->h.count - pos;
+    memmove(in->keys + pos + 1, in->keys + pos, (size_t)move * sizeof(int));
+    memmove(in->sizes + pos + 1, in->sizes + pos, (size_t)move * sizeof(long long));
+    memmove(in->child + pos + 1, in->child + pos, (size_t)move * sizeof(BtNode*));
+    in->keys[pos] = key;
+    in->sizes[pos] = size;
+    in->child[pos] = child;
+    in->h.count++;
+}
+
+static void inner_remove_at(BtInner* in, int pos) {
+    int move = in->h.count - pos - 1;
+    memmove(in->keys + pos, in->keys + pos + 1, (size_t)move * sizeof(int));
+    memmove(in->sizes + pos, in->sizes + pos + 1, (size_t)move * sizeof(long long));
+    memmove(in->child + pos, in->child + pos + 1, (size_t)move * sizeof(BtNode*));
+    in->h.count--;
+}
+
+// 2. 룺ʱȷѣ*right µҽ㡣
+// ҪĽ㶼޸֮ǰãڴ治ʱ -1 ԭ
+static int bt_insert(BtNode* node, int v, BtNode** right) {
+    *right = NULL;
+    if (node->leaf) {
+        BtLeaf* lf = (BtLeaf*)node;
+        if (lf->h.count == BT_LEAF) {
+            BtLeaf* r = leaf_new();
+            if (!r) return -1;
+            int half = BT_LEAF / 2;
+            memcpy(r->keys, lf->keys + half, (size_t)(BT_LEAF - half) * sizeof(int));
+            r->h.count = BT_LEAF - half;
+            lf->h.count = half;
+            r->next = lf->next;
+            lf->next = r;
+            *right = &r->h;
+            if (v > lf->keys[half - 1]) lf = r;
+        }
+        int pos = leaf_bound(lf, v, 0);
+        memmove(lf->keys + pos + 1, lf->keys + pos, (size_t)(lf->h.count - pos) * sizeof(int));
+        lf->keys[pos] = v;
+        lf->h.count++;
+        return 0;
+    }
+
+    BtInner* in = (BtInner*)node;
+    BtInner* spare = NULL;
+    if (in->h.count == BT_INNER) {
+        spare = inner_new();
+        if (!spare) return -1;
+    }
+    int i = inner_route(in, v, 0);
+    BtNode* split;
+    if (bt_insert(in->child[i], v, &split) != 0) {
+        free(spare);
+        return -1;
+    }
+    in->sizes[i]++;
+    if (!split) {
+        free(spare);
+        return 0;
+    }
+    long long splitSize = node_size(split);
+    in->sizes[i] -= splitSize;
+    int pos = i + 1;
+    int key = node_first_key(split);
+    if (!spare) {
+        inner_insert_at(in, pos, split, key, splitSize);
+        return 0;
+    }
+    // ҲˣһƵ spareӽһ
+    int half = BT_INNER / 2;
+    int move = BT_INNER - half;
+    memcpy(spare->keys, in->keys + half, (size_t)move * sizeof(int));
+    memcpy(spare->sizes, in->sizes + half, (size_t)move * sizeof(long long));
+    memcpy(spare->child, in->child + half, (size_t)move * sizeof(BtNode*));
+    spare->h.count = move;
+    in->h.count = half;
+    if (pos <= half) inner_insert_at(in, pos, split, key, splitSize);
+    else inner_insert_at(spare, pos - half, split, key, splitSize);
+    *right = &spare->h;
+    return 0;
+}
+
+// 3. ɾɾӽ㲻ʱֵܺϲһ
+static void rebalance(BtInner* in, int i) {
+    if (in->h.count < 2) return;
+    int l = i + 1 < in->h.count ? i : i - 1;
+    int r = l + 1;
+
+    if (in->child[l]->leaf) {
+        BtLeaf* L = (BtLeaf*)in->child[l];
+        BtLeaf* R = (BtLeaf*)in->child[r];
+        int total = L->h.count + R->h.count;
+        if (total <= BT_LEAF) {
+            memcpy(L->keys + L->h.count, R->keys, (size_t)R->h.count * sizeof(int));
+            L->h.count = total;
+            L->next = R->next;
+            in->sizes[l] = total;
+            free(R);
+            inner_remove_at(in, r);
+            return;
+        }
+        int half = total / 2;
+        if (L->h.count < half) {
+            int k = half - L->h.count;
+            memcpy(L->keys + L->h.count, R->keys, (size_t)k * sizeof(int));
+            memmove(R->keys, R->keys + k, (size_t)(R->h.count - k) * sizeof(int));
+        }
+        else {
+            int k = L->h.count - half;
+            memmove(R->keys + k, R->keys, (size_t)R->h.count * sizeof(int));
+            memcpy(R->keys, L->keys + half, (size_t)k * sizeof(int));
+        }
+        L->h.count = half;
+        R->h.count = total - half;
+        in->sizes[l] = L->h.count;
+        in->sizes[r] = R->h.count;
+        in->keys[r] = R->keys[0];
+        return;
+    }
+
+    BtInner* L = (BtInner*)in->child[l];
+    BtInner* R = (BtInner*)in->child[r];
+    R->keys[0] = in->keys[r];
+    int total = L->h.count + R->h.count;
+    if (total <= BT_INNER) {
+        memcpy(L->keys + L->h.count, R->keys, (size_t)R->h.count * sizeof(int));
+        memcpy(L->sizes + L->h.count, R->sizes, (size_t)R->h.count * sizeof(long long));
+        memcpy(L->child + L->h.count, R->child, (size_t)R->h.count * sizeof(BtNode*));
+        L->h.count = total;
+        in->sizes[l] += in->sizes[r];
+        free(R);
+        inner_remove_at(in, r);
+        return;
+    }
+    int half = total / 2;
+    if (L->h.count < half) {
+        int k = half - L->h.count;
+        memcpy(L->keys + L->h.count, R->keys, (size_t)k * sizeof(int));
+        memcpy(L->sizes + L->h.count, R->sizes, (size_t)k * sizeof(long long));
+        memcpy(L->child + L->h.count, R->child, (size_t)k * sizeof(BtNode*));
+        int rest = R->h.count - k;
+        memmove(R->keys, R->keys + k, (size_t)rest * sizeof(int));
+        memmove(R->sizes, R->sizes + k, (size_t)rest * sizeof(long long));
+        memmove(R->child, R->child + k, (size_t)rest * sizeof(BtNode*));
+    }
+    else {
+        int k = L->h.count - half;
+        memmove(R->keys + k, R->keys, (size_t)R->h.count * sizeof(int));
+        memmove(R->sizes + k, R->sizes, (size_t)R->h.count * sizeof(long long));
+        memmove(R->child + k, R->child, (size_t)R->h.count * sizeof(BtNode*));
+        memcpy(R->keys, L->keys + half, (size_t)k * sizeof(int));
+        memcpy(R->sizes, L->sizes + half, (size_t)k * sizeof(long long));
+        memcpy(R->child, L->child + half, (size_t)k * sizeof(BtNode*));
+    }
+    L->h.count = half;
+    R->h.count = total - half;
+    in->sizes[l] = node_size(&L->h);
+    in->sizes[r] = node_size(&R->h);
+    in->keys[r] = R->keys[0];
+}
+
+static void bt_erase_at(BtNode* node, long long pos) {
+    if (node->leaf) {
+        BtLeaf* lf = (BtLeaf*)node;
+        int p = (int)pos;
+        memmove(lf->keys + p, lf->keys + p + 1, (size_t)(lf->h.count - p - 1) * sizeof(int));
+        lf->h.count--;
+        return;
+    }
+    BtInner* in = (BtInner*)node;
+    int i = 0;
+    while (pos >= in->sizes[i]) pos -= in->sizes[i++];
+    bt_erase_at(in->child[i], pos);
+    in->sizes[i]--;
+    int minCount = in->child[i]->leaf ? BT_LEAF_MIN : BT_INNER_MIN;
+    if (in->child[i]->count < minCount) rebalance(in, i);
+}
+
+// 4. ѯ
+static long long bt_count_below(const SortTree* t, int v, int inclusive) {
+    const BtNode* node = t->root;
+    long long r = 0;
+    while (!node->leaf) {
+        const BtInner* in = (const BtInner*)node;
+        int i = inner_route(in, v, inclusive);
+        for (int j = 0; j < i; j++) r += in->sizes[j];
+        node = in->child[i];
+    }
+    return r + leaf_bound((const BtLeaf*)node, v, inclusive);
+}
+
+//  pos ڵҶҶ±
+static const BtLeaf* bt_locate(const SortTree* t, long long pos, int* offset) {
+    const BtNode* node = t->root;
+    while (!node->leaf) {
+        const BtInner* in = (const BtInner*)node;
+        int i = 0;
+        while (i + 1 < in->h.count && pos >= in->sizes[i]) pos -= in->sizes[i++];
+        node = in->child[i];
+    }
+    *offset = (int)pos;
+    return (const BtLeaf*)node;
+}
+
+// 5. ԵϽԪƽ
+static BtNode* bt_build(const int* a, long long n) {
+    if (n == 0) return (BtNode*)leaf_new();
+    long long count = (n + BT_BUILD_LEAF - 1) / BT_BUILD_LEAF;
+    BtNode** level = (BtNode**)malloc((size_t)count * sizeof(BtNode*));
+    long long* sizes = (long long*)malloc((size_t)count * sizeof(long long));
+    if (!level || !sizes) {
+        free(level); free(sizes);
+        return NULL;
+    }
+    long long made = 0, off = 0;
+    BtLeaf* prev = NULL;
+    for (; made < count; made++) {
+        BtLeaf* lf = leaf_new();
+        if (!lf) break;
+        int len = (int)(n / count + (made < n % count));
+        memcpy(lf->keys, a + off, (size_t)len * sizeof(int));
+        lf->h.count = len;
+        off += len;
+        if (prev) prev->next = lf;
+        prev = lf;
+        level[made] = &lf->h;
+        sizes[made] = len;
+    }
+
+    while (made == count && count > 1) {
+        long long parents = (count + BT_BUILD_INNER - 1) / BT_BUILD_INNER;
+        long long idx = 0, p = 0;
+        for (; p < parents; p++) {
+            BtInner* in = inner_new();
+            if (!in) break;
+            int len = (int)(count / parents + (p < count % parents));
+            long long total = 0;
+            for (int j = 0; j < len; j++, idx++) {
+                in->child[j] = level[idx];
+                in->sizes[j] = sizes[idx];
+                in->keys[j] = node_first_key(level[idx]);
+                total += sizes[idx];
+            }
+            in->h.count = len;
+            level[p] = &in->h;
+            sizes[p] = total;
+        }
+        if (p < parents) {
+            // ѽõĸͬͷţʣӽ㵥ͷ
+            for (long long j = 0; j < p; j++) node_free(level[j]);
+            for (long long j = idx; j < count; j++) node_free(level[j]);
+            made = 0;
+            count = 0;
+            break;
+        }
+        count = parents;
+        made = parents;
+    }
+    BtNode* root = NULL;
+    if (made == count && count == 1) root = level[0];
+    else for (long long j = 0; j < made; j++) node_free(level[j]);
+    free(level);
+    free(sizes);
+    return root;
+}
+
+// 6. ӿ
+EXPORT SortTree* sort_tree_create(void) {
+    SortTree* t = (SortTree*)calloc(1, sizeof(SortTree));
+    if (!t) return NULL;
+    t->root = (BtNode*)leaf_new();
+    if (!t->root) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+EXPORT void sort_tree_destroy(SortTree* t) {
+    if (!t) return;
+    node_free(t->root);
+    free(t);
+}
+
+EXPORT long long sort_tree_size(const SortTree* t) {
+    return t ? t->size : 0;
+}
+
+EXPORT int sort_tree_insert(SortTree* t, int value) {
+    if (!t) return -1;
+    BtInner* root = NULL;
+    if (t->root->count == (t->root->leaf ? BT_LEAF : BT_INNER)) {
+        root = inner_new();   // ܷѣǰ¸
+        if (!root) return -1;
+    }
+    BtNode* split;
+    if (bt_insert(t->root, value, &split) != 0) {
+        free(root);
+        return -1;
+    }
+    t->size++;
+    if (!split) {
+        free(root);
+        return 0;
+    }
+    long long rightSize = node_size(split);
+    root->child[0] = t->root;
+    root->sizes[0] = t->size - rightSize;
+    root->keys[0] = node_first_key(t->root);
+    root->child[1] = split;
+    root->sizes[1] = rightSize;
+    root->keys[1] = node_first_key(split);
+    root->h.count = 2;
+    t->root = &root->h;
+    return 0;
+}
+
+EXPORT int sort_tree_insert_bulk(SortTree* t, const int* values, int n) {
+    if (!t || n < 0 || (!values && n > 0)) return -1;
+    if (n == 0) return 0;
+    int* batch = (int*)malloc((size_t)n * sizeof(int));
+    if (!batch) return -1;
+    memcpy(batch, values, (size_t)n * sizeof(int));
+    _RadixSortFast(batch, n);
+
+    if ((long long)n * BT_BULK_RATIO < t->size) {
+        // ԽС˳룬ڲͬһҶ
+        for (int i = 0; i < n; i++) {
+            if (sort_tree_insert(t, batch[i]) != 0) {
+                free(batch);
+                return -1;
+            }
+        }
+        free(batch);
+        return 0;
+    }
+
+    // νϴȡԪι鲢ؽ
+    long long total = t->size + n;
+    int* merged = (int*)malloc((size_t)total * sizeof(int));
+    if (!merged) {
+        free(batch);
+        return -1;
+    }
+    int* old = merged + n;   // Ԫȷں󲿣鲢ǰдḲδ
+    sort_tree_copy(t, 0, old, (int)t->size);
+    long long i = 0, j = 0, o = 0;
+    while (i < t->size && j < n) merged[o++] = old[i] <= batch[j] ? old[i++] : batch[j++];
+    while (j < n) merged[o++] = batch[j++];
+    BtNode* root = bt_build(merged, total);
+    free(merged);
+    free(batch);
+    if (!root) return -1;
+    node_free(t->root);
+    t->root = root;
+    t->size = total;
+    return 0;
+}
+
+EXPORT int sort_tree_erase(SortTree* t, int value) {
+    if (!t) return -1;
+    long long pos = bt_count_below(t, value, 0);
+    int found;
+    if (pos >= t->size || sort_tree_select(t, pos, &found) != 0 || found != value) return 0;
+    bt_erase_at(t->root, pos);
+    t->size--;
+    // ֻʣһӽʱһ
+    while (!t->root->leaf && t->root->count == 1) {
+        BtInner* old = (BtInner*)t->root;
+        t->root = old->child[0];
+        free(old);
+    }
+    return 1;
+}
+
+EXPORT long long sort_tree_rank(const SortTree* t, int value) {
+    return t ? bt_count_below(t, value, 0) : -1;
+}
+
+EXPORT int sort_tree_select(const SortTree* t, long long index, int* value) {
+    if (!t || !value || index < 0 || index >= t->size) return -1;
+    int offset;
+    const BtLeaf* lf = bt_locate(t, index, &offset);
+    *value = lf->keys[offset];
+    return 0;
+}
+
+EXPORT int sort_tree_copy(const SortTree* t, long long start, int* out, int count) {
+    if (!t || start < 0 || count < 0 || (!out && count > 0)) return -1;
+    if (start >= t->size || count == 0) return 0;
+    if ((long long)count > t->size - start) count = (int)(t->size - start);
+    int offset;
+    const BtLeaf* lf = bt_locate(t, start, &offset);
+    int done = 0;
+    while (done < count) {
+        int take = lf->h.count - offset;
+        if (take > count - done) take = count - done;
+        memcpy(out + done, lf->keys + offset, (size_t)take * sizeof(int));
+        done += take;
+        lf = lf->next;
+        offset = 0;
+    }
+    return done;
+}
+
+EXPORT int sort_tree_range(const SortTree* t, int lo, int hi, int* out, int capacity) {
+    if (!t || capacity < 0 || (!out && capacity > 0)) return -1;
+    if (lo > hi) return 0;
+    long long begin = bt_count_below(t, lo, 0);
+    long long end = bt_count_below(t, hi, 1);
+    long long total = end - begin;
+    sort_tree_copy(t, begin, out, total < capacity ? (int)total : capacity);
+    return total > 0x7fffffff ? 0x7fffffff : (int)total;
+}
@@ -1,12 +1,24 @@
-#include "sort_engine.h"
+#ifndef _WIN32
+#define _GNU_SOURCE    // clock_gettime/CLOCK_MONOTONIC ϸ C ׼ģʽ²
+#endif
+
+#include "sort_internal.h"
+#include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <windows.h> 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
-// ȫͳƱ
-static long long g_comparisons = 0;
-static long long g_moves = 0;
-static LARGE_INTEGER g_cpuFreq;
+// ͳƱֲ߳̾洢ÿεÿʼʱ㡢ʱһд SortContext
+// ˲ͬ߳ͬʱû
+static SORT_TLS long long g_comparisons = 0;
+static SORT_TLS long long g_moves = 0;
+static SORT_TLS int g_passes = 0;            // ˴㷨 () ʵִе
+static SORT_TLS SortContext* g_ctx = NULL;   // ǰִ߳еĵ
 
 // 0. ݽṹ
 typedef struct {
@@ -14,248 +26,406 @@ typedef struct {
     int high;
 } StackNode;
 
-typedef struct {
-    StackNode* data;
-    int top;
-    int capacity;
-} SeqStack;
-
-void initStack(SeqStack* s, int capacity) {
-    s->data = (StackNode*)malloc(capacity * sizeof(StackNode));
-    s->top = -1;
-    s->capacity = capacity;
+// ջֻѹϴһ࣬Ȳ log2(n) < 32
+#define QS_STACK_DEPTH 64
+
+// 
+void reset_stats() {
+    g_comparisons = 0;
+    g_moves = 0;
+    g_passes = 0;
 }
 
-int isStackEmpty(SeqStack* s) {
-    return s->top == -1;
+void stats_take(long long* cmp, long long* moves) {
+    *cmp = g_comparisons;
+    *moves = g_moves;
+    reset_stats();
 }
 
-void push(SeqStack* s, int low, int high) {
-    if (s->top < s->capacity - 1) {
-        s->top++;
-        s->data[s->top].low = low;
-        s->data[s->top].high = high;
-    }
+void stats_add(long long cmp, long long moves) {
+    g_comparisons += cmp;
+    g_moves += moves;
 }
 
-void pop(SeqStack* s, int* low, int* high) {
-    if (s->top >= 0) {
-        *low = s->data[s->top].low;
-        *high = s->data[s->top].high;
-        s->top--;
+int min_val(int x, int y) {
+    return x < y ? x : y;
+}
+
+// Сʱ飺ĴڴʱӳУ (زʱ) malloc
+static void* scratch_alloc(size_t bytes) {
+    if (g_ctx && g_ctx->arena) {
+        void* p = arena_alloc(g_ctx->arena, bytes);
+        if (p) return p;
     }
+    return malloc(bytes);
 }
 
-void freeStack(SeqStack* s) {
-    if (s->data) free(s->data);
+// еĿõ scratch ʱͳһ黹ֻͷ malloc Ŀ
+static void scratch_free(void* p) {
+    if (g_ctx && p && (p == g_ctx->scratch || (g_ctx->arena && arena_owns(g_ctx->arena, p)))) return;
+    free(p);
 }
 
-// 
-void reset_stats() {
-    g_comparisons = 0;
-    g_moves = 0;
+//  n  int ʱ壺ṩ scratch 㹻ʱֱӸ
+static int* scratch_acquire(int n) {
+    if (g_ctx && g_ctx->scratch && g_ctx->scratchCapacity >= n) return g_ctx->scratch;
+    return (int*)scratch_alloc((size_t)n * sizeof(int));
 }
 
-void swap(int* a, int* b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-    g_moves += 3;
+static void scratch_release(int* p) {
+    scratch_free(p);
 }
 
-int min_val(int x, int y) {
-    return x < y ? x : y;
+// 㷨ʹõ߳δָʱȡӲ߳
+static int ctx_threads(void) {
+    int t = g_ctx ? g_ctx->threads : 0;
+    if (t <= 0) t = pool_hardware_threads();
+    return t < POOL_MAX_THREADS ? t : POOL_MAX_THREADS;
+}
+
+// ʱ ()Windows  QPCƽ̨ CLOCK_MONOTONIC
+EXPORT double get_time_ms(void) {
+#ifdef _WIN32
+    // Ƶڿ󲻱䣬ֻѯһ (״εдͬһֵ)
+    static volatile LONGLONG freq = 0;
+    LARGE_INTEGER t;
+    if (freq == 0) {
+        QueryPerformanceFrequency(&t);
+        freq = t.QuadPart;
+    }
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1000.0 / freq;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
+
+EXPORT void sort_context_init(SortContext* ctx) {
+    memset(ctx, 0, sizeof(SortContext));
 }
 
-// ִͨ
-SortPerformance run_sort(void (*func)(int*, int), int* arr, int n, char* name) {
-    SortPerformance sp;
-    memset(&sp, 0, sizeof(SortPerformance));
-    strncpy_s(sp.algorithm, 30, name, _TRUNCATE);
-    sp.dataSize = n;
+// ִͨд ctx->stats
+static void run_kernel(SortContext* ctx, void (*func)(int*, int), int* arr, int n, const char* name) {
+    SortPerformance* sp = &ctx->stats;
+    memset(sp, 0, sizeof(SortPerformance));
+    snprintf(sp->algorithm, sizeof(sp->algorithm), "%s", name);
+    sp->dataSize = n;
 
     reset_stats();
-    QueryPerformanceFrequency(&g_cpuFreq);
+    g_ctx = ctx;
 
-    LARGE_INTEGER start, end;
-    QueryPerformanceCounter(&start);
+    double start = get_time_ms();
     func(arr, n);
-    QueryPerformanceCounter(&end);
-
-    sp.compareCount = g_comparisons;
-    sp.moveCount = g_moves;
-    sp.timeCost = (double)(end.QuadPart - start.QuadPart) * 1000.0 / g_cpuFreq.QuadPart;
+    double end = get_time_ms();
 
-    return sp;
+    g_ctx = NULL;
+    if (ctx->arena) arena_end_run(ctx->arena);
+    sp->compareCount = g_comparisons;
+    sp->moveCount = g_moves;
+    sp->passes = g_passes;
+    sp->timeCost = end - start;
 }
 
-// 
-EXPORT void generate_data_c(int* arr, int n, int type) {
-    srand((unsigned)GetTickCount64());
-    for (int i = 0; i < n; i++) arr[i] = rand() % 10000;
-    if (type == 1) { // 
-        for (int i = 0; i < n - 1; i++)
-            for (int j = 0; j < n - 1 - i; j++)
-                if (arr[j] > arr[j + 1]) { int t = arr[j]; arr[j] = arr[j + 1]; arr[j + 1] = t; }
+// 㷨ʵ
+#define PAR_MIN_SIZE 8192    // Сڴ˹ģĲ㷨ֱӵִ߳
+#define PAR_RUN 32           // й鲢ĳʼγ
+#define PAR_QS_CUTOFF 4096   // пСڴ˳ȵ䲻ٲ
+#define PAR_QS_INSERT 16     // С
+#define NET_RUN 32           // 鲢/ײ㽻Ŀ鳤 ( SIMD_NET_MAX)
+#define RADIX_BITS 8         // ÿ˴λ
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (32 / RADIX_BITS)
+#define RADIX_WC 16          // дϲ壺ÿͰ 16  intһ 64 ֽڻ
+#define RADIX_MIN_SIZE 64    // Сڴ˹ģĻò
+#define TIM_MIN_MERGE 32     // TimSort Сڴ˹ģֱӶֲ룬Ҳ minRun Ͻ
+#define TIM_MIN_GALLOP 7     //  galloping ģʽĳʼż
+#define TIM_MAX_RUNS 85      // ջջʽ֤ int ΧԶò
+#define SELECT_SMALL 16      // ѡ㷨Сڴ˳ȵֱӲ
+#define PARTIAL_HEAP_RATIO 32 //  k <= n / ֵʱöѣѡ
+#define PARTIAL_REPLACE_RATIO 16 // ѵ滻 n / ֵ + k ʱ
+
+// TimSort ״̬ (ں˹)
+typedef struct {
+    int base;
+    int len;
+} TimRun;
+
+typedef struct {
+    int* arr;
+    int n;
+    int* buf;                // 鲢壬϶̶εĳȰ
+    int bufCap;
+    int bufOwned;            // buf ǷΪ ( ctx->scratch)
+    int minGallop;
+    TimRun runs[TIM_MAX_RUNS];
+    int runCount;
+} TimState;
+
+// 棺ͳƱȽ/ƶڽѧ뱨
+#define SORT_FN(name) name
+#define COUNT_CMP() (g_comparisons++)
+#define COUNT_MOVE(k) (g_moves += (k))
+#define SORT_NETWORK(a, n) _ScalarNetwork(a, n)
+#define SORT_T int
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_HEAPSORT(a, n) SORT_FN(_HeapSort)(a, n)
+#define TRACE_CMP(p, q) ((void)0)
+#define TRACE_SWAP(p, q) ((void)0)
+#define TRACE_WRITE(p) ((void)0)
+#define TRACE_PHASE(p) ((void)0)
+#include "sort_kernels.h"
+#include "sort_kernels_parallel.h"
+#include "sort_kernels_radix.h"
+#include "sort_kernels_pdq.h"
+#include "sort_kernels_tim.h"
+#include "sort_kernels_pingpong.h"
+#include "sort_kernels_select.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+#undef SORT_NETWORK
+#undef SORT_T
+#undef SORT_LESS
+#undef SORT_HEAPSORT
+#undef TRACE_CMP
+#undef TRACE_SWAP
+#undef TRACE_WRITE
+#undef TRACE_PHASE
+
+// 㿪棺κμʵܲ
+#define SORT_FN(name) name##Fast
+#define COUNT_CMP() ((void)0)
+#define COUNT_MOVE(k) ((void)0)
+#define SORT_NETWORK(a, n) simd_network_sort(a, n)
+#define SORT_T int
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_HEAPSORT(a, n) SORT_FN(_HeapSort)(a, n)
+#define TRACE_CMP(p, q) ((void)0)
+#define TRACE_SWAP(p, q) ((void)0)
+#define TRACE_WRITE(p) ((void)0)
+#define TRACE_PHASE(p) ((void)0)
+#include "sort_kernels.h"
+#include "sort_kernels_parallel.h"
+#include "sort_kernels_radix.h"
+#include "sort_kernels_pdq.h"
+#include "sort_kernels_tim.h"
+#include "sort_kernels_pingpong.h"
+#include "sort_kernels_select.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+#undef SORT_NETWORK
+#undef SORT_T
+#undef SORT_LESS
+#undef SORT_HEAPSORT
+#undef TRACE_CMP
+#undef TRACE_SWAP
+#undef TRACE_WRITE
+#undef TRACE_PHASE
+
+// ׷ٰ棺ͬ棬ÿαȽ//д뽻 sort_trace.c ¼
+// ֻо㷨 (sort_kernels.h) ׷ٰ棬СñԱ¼д
+#define SORT_FN(name) name##Trace
+#define COUNT_CMP() (g_comparisons++)
+#define COUNT_MOVE(k) (g_moves += (k))
+#define SORT_NETWORK(a, n) _ScalarNetworkTrace(a, n)
+#define SORT_T int
+#define SORT_LESS(a, b) ((a) < (b))
+#define TRACE_CMP(p, q) trace_emit(SORT_EV_COMPARE, p, q)
+#define TRACE_SWAP(p, q) trace_emit(SORT_EV_SWAP, p, q)
+#define TRACE_WRITE(p) trace_emit(SORT_EV_WRITE, p, NULL)
+#define TRACE_PHASE(p) trace_emit(SORT_EV_PHASE, p, NULL)
+#include "sort_kernels.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+#undef SORT_NETWORK
+#undef SORT_T
+#undef SORT_LESS
+#undef TRACE_CMP
+#undef TRACE_SWAP
+#undef TRACE_WRITE
+#undef TRACE_PHASE
+
+// 㷨± SortAlgorithm һ
+typedef struct {
+    const char* name;
+    void (*counted)(int*, int);
+    void (*fast)(int*, int);
+} AlgoEntry;
+
+static const AlgoEntry g_algoTable[SORT_ALGO_COUNT] = {
+    { "Bubble Sort",    _BubbleSort,         _BubbleSortFast },
+    { "Insertion Sort", _InsertSort,         _InsertSortFast },
+    { "Selection Sort", _SelectSort,         _SelectSortFast },
+    { "Shell Sort",     _ShellSort,          _ShellSortFast },
+    { "Quick Sort",     _QuickSortIterative, _QuickSortIterativeFast },
+    { "Merge Sort",     _MergeSortIterative, _MergeSortIterativeFast },
+    { "Heap Sort",      _HeapSort,           _HeapSortFast },
+    { "Parallel Merge", _ParallelMergeSort,  _ParallelMergeSortFast },
+    { "Parallel Quick", _ParallelQuickSort,  _ParallelQuickSortFast },
+    { "Radix Sort",     _RadixSort,          _RadixSortFast },
+    { "Pdq Sort",       _PdqSort,            _PdqSortFast },
+    { "Tim Sort",       _TimSort,            _TimSortFast },
+    { "PingPong Merge", _PingPongMergeSort,  _PingPongMergeSortFast },
+    { "PingPong Merge4", _PingPongMergeSort4, _PingPongMergeSort4Fast },
+    { "Counting Sort",  _CountingSort,       _CountingSortFast },
+    { "Auto",           NULL,                NULL },   // sort_run ֱӽ auto_dispatch
+};
+
+// Ľӿڣʱд ctx->statsɰȫر߳ͬʱ
+EXPORT int sort_run(SortContext* ctx, int algo, int* arr, int n) {
+    if (!ctx || (!arr && n > 0) || n < 0 || algo < 0 || algo >= SORT_ALGO_COUNT) return -1;
+    if (algo == SORT_AUTO) return auto_dispatch(ctx, arr, n);
+    const AlgoEntry* e = &g_algoTable[algo];
+    if (ctx->options & SORT_OPT_FAST) {
+        char name[30];
+        snprintf(name, sizeof(name), "%s (Fast)", e->name);
+        run_kernel(ctx, e->fast, arr, n, name);
     }
-    else if (type == 2) { // 
-        for (int i = 0; i < n - 1; i++)
-            for (int j = 0; j < n - 1 - i; j++)
-                if (arr[j] < arr[j + 1]) { int t = arr[j]; arr[j] = arr[j + 1]; arr[j + 1] = t; }
+    else {
+        run_kernel(ctx, e->counted, arr, n, e->name);
     }
+    return 0;
 }
 
-// 㷨ʵ
+// ׷ٰ㷨± SortAlgorithm һ£ֻǾ㷨
+static void (*const g_traceTable[])(int*, int) = {
+    _BubbleSortTrace, _InsertSortTrace, _SelectSortTrace, _ShellSortTrace,
+    _QuickSortIterativeTrace, _MergeSortIterativeTrace, _HeapSortTrace,
+};
 
-// 1. ð
-void _BubbleSort(int arr[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - 1 - i; j++) {
-            g_comparisons++;
-            if (arr[j] > arr[j + 1]) swap(&arr[j], &arr[j + 1]);
-        }
-    }
+int sort_run_traced(int algo, int* arr, int n, SortPerformance* stats) {
+    if (algo < 0 || algo >= (int)(sizeof(g_traceTable) / sizeof(g_traceTable[0]))) return -1;
+    SortContext ctx;
+    sort_context_init(&ctx);
+    char name[30];
+    snprintf(name, sizeof(name), "%s (Trace)", g_algoTable[algo].name);
+    run_kernel(&ctx, g_traceTable[algo], arr, n, name);
+    if (stats) *stats = ctx.stats;
+    return 0;
 }
 
-// 2. 
-void _InsertSort(int arr[], int n) {
-    for (int i = 1; i < n; i++) {
-        int temp = arr[i]; g_moves++;
-        int j = i - 1;
-        while (j >= 0) {
-            g_comparisons++;
-            if (arr[j] > temp) {
-                arr[j + 1] = arr[j]; g_moves++;
-                j--;
-            }
-            else break;
-        }
-        arr[j + 1] = temp; g_moves++;
-    }
+// ӿڣʱԭһ memcpyͼռڴ棬д
+static void gather(const SortBuffer* buf, int* dst) {
+    const char* p = (const char*)buf->ptr;
+    for (int i = 0; i < buf->length; i++, p += buf->stride) dst[i] = *(const int*)p;
 }
 
-// 3. ѡ
-void _SelectSort(int arr[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        int minIdx = i;
-        for (int j = i + 1; j < n; j++) {
-            g_comparisons++;
-            if (arr[j] < arr[minIdx]) minIdx = j;
-        }
-        if (minIdx != i) swap(&arr[i], &arr[minIdx]);
-    }
+static void scatter(const int* src, const SortBuffer* buf) {
+    char* p = (char*)buf->ptr;
+    for (int i = 0; i < buf->length; i++, p += buf->stride) *(int*)p = src[i];
 }
 
-// 4. ϣ
-void _ShellSort(int arr[], int n) {
-    for (int gap = n / 2; gap > 0; gap /= 2) {
-        for (int i = gap; i < n; i++) {
-            int temp = arr[i]; g_moves++;
-            int j = i;
-            while (j >= gap) {
-                g_comparisons++;
-                if (arr[j - gap] > temp) {
-                    arr[j] = arr[j - gap]; g_moves++;
-                    j -= gap;
-                }
-                else break;
-            }
-            arr[j] = temp; g_moves++;
-        }
-    }
-}
+EXPORT int sort_buffer(SortContext* ctx, int algo, const SortBuffer* buf, int* out) {
+    if (!ctx || !buf || buf->length < 0 || (!buf->ptr && buf->length > 0)) return -1;
+    SortBuffer view = *buf;
+    if (view.stride == 0) view.stride = sizeof(int);
+    int n = view.length;
+    int dense = view.stride == (long long)sizeof(int);
 
-// 5. 
-void _HeapAdjustIterative(int arr[], int n, int i) {
-    int temp = arr[i]; g_moves++;
-    int k = 2 * i + 1;
-    while (k < n) {
-        if (k + 1 < n) {
-            g_comparisons++;
-            if (arr[k] < arr[k + 1]) k++;
-        }
-        g_comparisons++;
-        if (arr[k] > temp) {
-            arr[i] = arr[k]; g_moves++;
-            i = k;
-            k = 2 * i + 1;
-        }
-        else break;
-    }
-    arr[i] = temp; g_moves++;
-}
-void _HeapSort(int arr[], int n) {
-    for (int i = n / 2 - 1; i >= 0; i--) _HeapAdjustIterative(arr, n, i);
-    for (int i = n - 1; i > 0; i--) {
-        swap(&arr[0], &arr[i]);
-        _HeapAdjustIterative(arr, i, 0);
+    if (!(ctx->options & SORT_OPT_NO_COPY)) {
+        if (!out && n > 0) return -1;
+        if (dense) memcpy(out, view.ptr, (size_t)n * sizeof(int));
+        else gather(&view, out);
+        return sort_run(ctx, algo, out, n);
     }
-}
+    if (dense) return sort_run(ctx, algo, (int*)view.ptr, n);
 
-// 6. 鲢
-void _Merge(int arr[], int l, int m, int r, int temp[]) {
-    int i = l, j = m + 1, k = l;
-    while (i <= m && j <= r) {
-        g_comparisons++;
-        if (arr[i] <= arr[j]) { temp[k++] = arr[i++]; g_moves++; }
-        else { temp[k++] = arr[j++]; g_moves++; }
-    }
-    while (i <= m) { temp[k++] = arr[i++]; g_moves++; }
-    while (j <= r) { temp[k++] = arr[j++]; g_moves++; }
-    for (i = l; i <= r; i++) { arr[i] = temp[i]; g_moves++; }
-}
-void _MergeSortIterative(int arr[], int n) {
-    int* temp = (int*)malloc(n * sizeof(int));
-    if (!temp) return;
-
-    for (int curr_size = 1; curr_size <= n - 1; curr_size = 2 * curr_size) {
-        for (int left_start = 0; left_start < n - 1; left_start += 2 * curr_size) {
-            int mid = min_val(left_start + curr_size - 1, n - 1);
-            int right_end = min_val(left_start + 2 * curr_size - 1, n - 1);
-            _Merge(arr, left_start, mid, right_end, temp);
-        }
-    }
-    free(temp);
+    int* tmp = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    if (!tmp) return -1;
+    gather(&view, tmp);
+    int ret = sort_run(ctx, algo, tmp, n);
+    if (ret == 0) scatter(tmp, &view);
+    free(tmp);
+    return ret;
 }
 
-// 7. 
-int _Partition(int arr[], int low, int high) {
-    int pivot = arr[high]; g_moves++;
-    int i = low - 1;
-    for (int j = low; j < high; j++) {
-        g_comparisons++;
-        if (arr[j] < pivot) {
-            i++;
-            swap(&arr[i], &arr[j]);
-        }
+// ѡӿڣʱʽ sort_run ͬ
+typedef void (*SelectKernel)(int*, int, int);
+
+static void run_select(const char* name, SelectKernel counted, SelectKernel fast, int* arr, int n, int k,
+    int options, SortPerformance* stats) {
+    char label[30];
+    snprintf(label, sizeof(label), (options & SORT_OPT_FAST) ? "%s (Fast)" : "%s", name);
+    reset_stats();
+    double start = get_time_ms();
+    ((options & SORT_OPT_FAST) ? fast : counted)(arr, n, k);
+    double end = get_time_ms();
+    if (stats) {
+        memset(stats, 0, sizeof(SortPerformance));
+        snprintf(stats->algorithm, sizeof(stats->algorithm), "%s", label);
+        stats->dataSize = n;
+        stats->compareCount = g_comparisons;
+        stats->moveCount = g_moves;
+        stats->timeCost = end - start;
     }
-    swap(&arr[i + 1], &arr[high]);
-    return i + 1;
 }
-void _QuickSortIterative(int arr[], int n) {
-    if (n <= 1) return;
 
-    SeqStack stack;
-    initStack(&stack, n); // ʼջ
-    push(&stack, 0, n - 1); // ѹʼ
+EXPORT int nth_element(int* arr, int n, int k, int options, SortPerformance* stats) {
+    if (!arr || n <= 0 || k < 0 || k >= n) return -1;
+    run_select("Nth Element", _NthElement, _NthElementFast, arr, n, k, options, stats);
+    return 0;
+}
 
-    while (!isStackEmpty(&stack)) {
-        int low, high;
-        pop(&stack, &low, &high);
+EXPORT int partial_sort(int* arr, int n, int k, int options, SortPerformance* stats) {
+    if ((!arr && n > 0) || n < 0 || k < 0 || k > n) return -1;
+    run_select("Partial Sort", _PartialSort, _PartialSortFast, arr, n, k, options, stats);
+    return 0;
+}
 
-        int pivot = _Partition(arr, low, high);
+// ݾɽӿڵıװ
+static SortPerformance run_algo(int algo, int options, int* arr, int n) {
+    SortContext ctx;
+    sort_context_init(&ctx);
+    ctx.options = options;
+    sort_run(&ctx, algo, arr, n);
+    return ctx.stats;
+}
 
-        if (pivot + 1 < high) push(&stack, pivot + 1, high);
-        if (low < pivot - 1) push(&stack, low, pivot - 1);
-    }
-    freeStack(&stack);
+static SortPerformance run_algo_threads(int algo, int options, int* arr, int n, int threads) {
+    SortContext ctx;
+    sort_context_init(&ctx);
+    ctx.options = options;
+    ctx.threads = threads;
+    sort_run(&ctx, algo, arr, n);
+    return ctx.stats;
 }
 
 // 
-EXPORT SortPerformance bubble_sort(int* arr, int n) { return run_sort(_BubbleSort, arr, n, "Bubble Sort"); }
-EXPORT SortPerformance insertion_sort(int* arr, int n) { return run_sort(_InsertSort, arr, n, "Insertion Sort"); }
-EXPORT SortPerformance selection_sort(int* arr, int n) { return run_sort(_SelectSort, arr, n, "Selection Sort"); }
-EXPORT SortPerformance shell_sort(int* arr, int n) { return run_sort(_ShellSort, arr, n, "Shell Sort"); }
-EXPORT SortPerformance quick_sort(int* arr, int n) { return run_sort(_QuickSortIterative, arr, n, "Quick Sort"); }
-EXPORT SortPerformance merge_sort(int* arr, int n) { return run_sort(_MergeSortIterative, arr, n, "Merge Sort"); }
-EXPORT SortPerformance heap_sort(int* arr, int n) { return run_sort(_HeapSort, arr, n, "Heap Sort"); }
\ No newline at end of file
+EXPORT SortPerformance bubble_sort(int* arr, int n) { return run_algo(SORT_BUBBLE, 0, arr, n); }
+EXPORT SortPerformance insertion_sort(int* arr, int n) { return run_algo(SORT_INSERTION, 0, arr, n); }
+EXPORT SortPerformance selection_sort(int* arr, int n) { return run_algo(SORT_SELECTION, 0, arr, n); }
+EXPORT SortPerformance shell_sort(int* arr, int n) { return run_algo(SORT_SHELL, 0, arr, n); }
+EXPORT SortPerformance quick_sort(int* arr, int n) { return run_algo(SORT_QUICK, 0, arr, n); }
+EXPORT SortPerformance merge_sort(int* arr, int n) { return run_algo(SORT_MERGE, 0, arr, n); }
+EXPORT SortPerformance heap_sort(int* arr, int n) { return run_algo(SORT_HEAP, 0, arr, n); }
+EXPORT SortPerformance parallel_merge_sort(int* arr, int n, int threads) { return run_algo_threads(SORT_PARALLEL_MERGE, 0, arr, n, threads); }
+EXPORT SortPerformance parallel_quick_sort(int* arr, int n, int threads) { return run_algo_threads(SORT_PARALLEL_QUICK, 0, arr, n, threads); }
+EXPORT SortPerformance radix_sort(int* arr, int n) { return run_algo(SORT_RADIX, 0, arr, n); }
+EXPORT SortPerformance pdq_sort(int* arr, int n) { return run_algo(SORT_PDQ, 0, arr, n); }
+EXPORT SortPerformance tim_sort(int* arr, int n) { return run_algo(SORT_TIM, 0, arr, n); }
+EXPORT SortPerformance pingpong_merge_sort(int* arr, int n) { return run_algo(SORT_PINGPONG, 0, arr, n); }
+EXPORT SortPerformance pingpong_merge_sort4(int* arr, int n) { return run_algo(SORT_PINGPONG4, 0, arr, n); }
+EXPORT SortPerformance counting_sort(int* arr, int n) { return run_algo(SORT_COUNTING, 0, arr, n); }
+EXPORT SortPerformance auto_sort(int* arr, int n) { return run_algo(SORT_AUTO, 0, arr, n); }
+
+// 㿪浼 (compareCount/moveCount Ϊ 0passes ճд)
+EXPORT SortPerformance bubble_sort_fast(int* arr, int n) { return run_algo(SORT_BUBBLE, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance insertion_sort_fast(int* arr, int n) { return run_algo(SORT_INSERTION, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance selection_sort_fast(int* arr, int n) { return run_algo(SORT_SELECTION, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance shell_sort_fast(int* arr, int n) { return run_algo(SORT_SHELL, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance quick_sort_fast(int* arr, int n) { return run_algo(SORT_QUICK, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance merge_sort_fast(int* arr, int n) { return run_algo(SORT_MERGE, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance heap_sort_fast(int* arr, int n) { return run_algo(SORT_HEAP, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance parallel_merge_sort_fast(int* arr, int n, int threads) { return run_algo_threads(SORT_PARALLEL_MERGE, SORT_OPT_FAST, arr, n, threads); }
+EXPORT SortPerformance parallel_quick_sort_fast(int* arr, int n, int threads) { return run_algo_threads(SORT_PARALLEL_QUICK, SORT_OPT_FAST, arr, n, threads); }
+EXPORT SortPerformance radix_sort_fast(int* arr, int n) { return run_algo(SORT_RADIX, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance pdq_sort_fast(int* arr, int n) { return run_algo(SORT_PDQ, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance tim_sort_fast(int* arr, int n) { return run_algo(SORT_TIM, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance pingpong_merge_sort_fast(int* arr, int n) { return run_algo(SORT_PINGPONG, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance pingpong_merge_sort4_fast(int* arr, int n) { return run_algo(SORT_PINGPONG4, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance counting_sort_fast(int* arr, int n) { return run_algo(SORT_COUNTING, SORT_OPT_FAST, arr, n); }
+EXPORT SortPerformance auto_sort_fast(int* arr, int n) { return run_algo(SORT_AUTO, SORT_OPT_FAST, arr, n); }
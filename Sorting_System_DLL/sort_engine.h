@@ -14,9 +14,62 @@ typedef struct {
     long long compareCount;
     long long moveCount;   
     double timeCost;       
+    int passes;            // ˴㷨ʵִе ()Ϊ 0
 } SortPerformance;
+
+typedef struct SortArena SortArena;
+
+// εģɵ߳Уͳƽʱѡ
+// ̸ͬ߳øļɲ
+typedef struct SortContext {
+    SortPerformance stats;   // 㷨/ģ/Ƚ/ƶ/ʱ ()/
+    int* scratch;            // ѡṩʱ壬鲢 malloc
+    int scratchCapacity;     // scratch ɵ int 
+    int options;             // SORT_OPT_* 
+    int threads;             // 㷨ʹõ߳<=0 ʾȡӲ߳
+    SortArena* arena;        // ѡ߳еʱڴأscratch ֮ʱ嶼п
+} SortContext;
 #pragma pack(pop)
 
+// sort_run 㷨
+typedef enum {
+    SORT_BUBBLE = 0,
+    SORT_INSERTION,
+    SORT_SELECTION,
+    SORT_SHELL,
+    SORT_QUICK,
+    SORT_MERGE,
+    SORT_HEAP,
+    SORT_PARALLEL_MERGE,
+    SORT_PARALLEL_QUICK,
+    SORT_RADIX,
+    SORT_PDQ,
+    SORT_TIM,
+    SORT_PINGPONG,
+    SORT_PINGPONG4,
+    SORT_COUNTING,
+    SORT_AUTO,               // Ӧѡĳ (sort_auto.c)
+    SORT_ALGO_COUNT
+} SortAlgorithm;
+
+#define SORT_OPT_FAST 0x1    // ʹ㿪 ()
+#define SORT_OPT_NO_COPY 0x2 // sort_buffer ֱڵ߻򣬲ȸƵ out
+
+// ߳е int ͼֱӶӦ Python Э / array.array / numpy (int32)
+typedef struct {
+    void* ptr;               // Ԫصַ
+    int length;              // Ԫظ
+    long long stride;        // Ԫؼֽ (Ϊ)0 ʾ
+} SortBuffer;
+
+// Сʹõָ
+typedef enum {
+    SORT_SIMD_NONE = 0,
+    SORT_SIMD_SSE41,
+    SORT_SIMD_AVX2,
+    SORT_SIMD_AVX512
+} SortSimdLevel;
+
 EXPORT SortPerformance bubble_sort(int* arr, int n);
 EXPORT SortPerformance insertion_sort(int* arr, int n);
 EXPORT SortPerformance selection_sort(int* arr, int n);
@@ -24,8 +77,347 @@ EXPORT SortPerformance shell_sort(int* arr, int n);
 EXPORT SortPerformance quick_sort(int* arr, int n);
 EXPORT SortPerformance merge_sort(int* arr, int n);
 EXPORT SortPerformance heap_sort(int* arr, int n);
+// LSD ָ֧compareCount Ϊ 0passes Ϊʵʷַ
+EXPORT SortPerformance radix_sort(int* arr, int n);
+// ģʽ O(n log n)ԣȶ
+EXPORT SortPerformance pdq_sort(int* arr, int n);
+// Ӧ鲢 (TimSort)ȶ/ O(n)
+EXPORT SortPerformance tim_sort(int* arr, int n);
+// ƹһ + ޷֧鲢ȶÿֻһΣ4 Ϊ·鲢
+EXPORT SortPerformance pingpong_merge_sort(int* arr, int n);
+EXPORT SortPerformance pingpong_merge_sort4(int* arr, int n);
+// ֵ򲻳Ԫ 8 ʱԣתcompareCount Ϊ 0
+EXPORT SortPerformance counting_sort(int* arr, int n);
+// Ӧalgorithm ֶΪ "Auto: " ʵʹõ
+EXPORT SortPerformance auto_sort(int* arr, int n);
+
+// 㷨threads Ϊ߳<=0 ʾȡӲ߳
+EXPORT SortPerformance parallel_merge_sort(int* arr, int n, int threads);
+EXPORT SortPerformance parallel_quick_sort(int* arr, int n, int threads);
+
+// 㿪棺ͬԴʱȥȫڲʵʱ
+EXPORT SortPerformance bubble_sort_fast(int* arr, int n);
+EXPORT SortPerformance insertion_sort_fast(int* arr, int n);
+EXPORT SortPerformance selection_sort_fast(int* arr, int n);
+EXPORT SortPerformance shell_sort_fast(int* arr, int n);
+EXPORT SortPerformance quick_sort_fast(int* arr, int n);
+EXPORT SortPerformance merge_sort_fast(int* arr, int n);
+EXPORT SortPerformance heap_sort_fast(int* arr, int n);
+EXPORT SortPerformance parallel_merge_sort_fast(int* arr, int n, int threads);
+EXPORT SortPerformance parallel_quick_sort_fast(int* arr, int n, int threads);
+EXPORT SortPerformance radix_sort_fast(int* arr, int n);
+EXPORT SortPerformance pdq_sort_fast(int* arr, int n);
+EXPORT SortPerformance tim_sort_fast(int* arr, int n);
+EXPORT SortPerformance pingpong_merge_sort_fast(int* arr, int n);
+EXPORT SortPerformance pingpong_merge_sort4_fast(int* arr, int n);
+EXPORT SortPerformance counting_sort_fast(int* arr, int n);
+EXPORT SortPerformance auto_sort_fast(int* arr, int n);
+
+// Ľӿ ()ɹ 0Ƿ -1
+EXPORT void sort_context_init(SortContext* ctx);
+EXPORT int sort_run(SortContext* ctx, int algo, int* arr, int n);
+// ӿڣĬȰ buf Ƶ out (У length  int) buf 䣻
+// options  SORT_OPT_NO_COPY ʱֱ buf out Ϊ NULLƲ stats.timeCost
+EXPORT int sort_buffer(SortContext* ctx, int algo, const SortBuffer* buf, int* out);
+
+// ݷֲ (generate_data_ex  type)ǰɽӿ generate_data_c һ
+typedef enum {
+    GEN_RANDOM = 0,          // 
+    GEN_SORTED,              // 
+    GEN_REVERSE,             // 
+    GEN_NEARLY_SORTED,       // ӽ param%  (Ĭ 1)
+    GEN_FEW_UNIQUE,          // ֻ param ֵͬ (Ĭ 10)
+    GEN_ORGAN_PIPE,          // ٹܣ
+    GEN_SAWTOOTH,            // ݣparam  (Ĭ 8)
+    GEN_ZIPF,                // Zipfȡֵ 1..nָΪ param/100 (Ĭ 1.0)
+    GEN_FULL_RANGE,          //  32 λзŷΧ
+    GEN_DIST_COUNT
+} SortDistribution;
 
 // ɽӿ
+// ֻ seed  (߳޹)зֲ O(n)鲢䡣
+// maxValue > 0 ʱֲȡֵ [0, maxValue)Ϊ [0, 2^31-1)ɹ 0
+EXPORT int generate_data_ex(int* arr, int n, int type, unsigned long long seed, int param, int maxValue);
+// ɽӿڣԵǰʱΪӣȡֵ [0, 10000)
 EXPORT void generate_data_c(int* arr, int n, int type);
 
+// ļ (sort_io.c)
+// Ƹʽ16 ֽļͷ count С int32ֱӳΪ
+#define SORT_BIN_MAGIC 0x42545253u   // "SRTB"
+#define SORT_BIN_INT32 1             // Ԫͣ32 λз
+
+typedef struct {
+    unsigned magic;                  // SORT_BIN_MAGIC
+    unsigned elemType;               // SORT_BIN_INT32
+    unsigned long long count;        // Ԫظ
+} SortBinHeader;
+
+// ȡıļеȫ (ַָ'-' ֱʾ)
+// ļڴӳ˽ļ threads ̷ֶ߳β (<=0 ȡӲ߳)
+// ɹ 0*arr  sort_free ͷ (ûʱΪ NULL)
+EXPORT int load_text_file(const char* path, int threads, int** arr, int* n);
+EXPORT void sort_free(void* p);
+// ӳļ*arr ֱָļݣơ
+// writable Ϊ 0 ʱдʱƣӰļΪ 1 ʱ޸дļ unmap_binary_file ͷ
+EXPORT int load_binary_file(const char* path, int writable, int** arr, int* n);
+// arr Ϊ load_binary_file صָ룬򷵻 -1 (Linux ¿ɼ)
+EXPORT int unmap_binary_file(int* arr);
+EXPORT int save_binary_file(const char* path, const int* arr, int n);
+
+// ѡ (sort_engine.c)options ɺ SORT_OPT_FASTstats Ϊ NULLɹ 0Ƿ -1
+//  arr ʹ arr[k] Ϊ k С ( 0 )඼Ҳ඼С0 <= k < n
+EXPORT int nth_element(int* arr, int n, int k, int options, SortPerformance* stats);
+//  arr ʹ arr[0..k) ΪС k ˳򲻶0 <= k <= n
+EXPORT int partial_sort(int* arr, int n, int k, int options, SortPerformance* stats);
+
+// ʽ top-k (sort_topk.c)ֿ pushʱȡǰ
+typedef struct TopKStream TopKStream;
+
+// largest  0 ʱ k С k ʧܷ NULL
+EXPORT TopKStream* topk_create(int k, int largest);
+EXPORT int topk_push(TopKStream* s, const int* chunk, int n);
+// дǰ (С k  /  k )ظstats Ϊۼ
+EXPORT int topk_result(TopKStream* s, int* out, SortPerformance* stats);
+EXPORT void topk_destroy(TopKStream* s);
+
+//  (sort_btree.c) B+ ظֵ
+typedef struct SortTree SortTree;
+
+EXPORT SortTree* sort_tree_create(void);
+EXPORT void sort_tree_destroy(SortTree* t);
+EXPORT long long sort_tree_size(const SortTree* t);
+// һֵ / һֵ (νϴʱ鲢ؽ)ɹ 0ڴ治㷵 -1
+EXPORT int sort_tree_insert(SortTree* t, int value);
+EXPORT int sort_tree_insert_bulk(SortTree* t, const int* values, int n);
+// ɾһ value Ԫأɾ 1ڷ 0
+EXPORT int sort_tree_erase(SortTree* t, int value);
+// С value Ԫظ
+EXPORT long long sort_tree_rank(const SortTree* t, int value);
+//  index С ( 0 ) Ԫд *valueԽ緵 -1
+EXPORT int sort_tree_select(const SortTree* t, long long index, int* value);
+//  [start, start + count) Ԫص outʵʸ
+EXPORT int sort_tree_copy(const SortTree* t, long long start, int* out, int count);
+//  [lo, hi] ڵԪأ capacity ڵԪ
+EXPORT int sort_tree_range(const SortTree* t, int lo, int hi, int* out, int capacity);
+
+// С (sort_batch.c)ηֱԭ򣬷 0 ɹ-1 Ƿ
+// options ɺ SORT_OPT_FASTthreads <= 0 ʾȡӲ߳stats ΪĻܣΪ NULL
+// offsets  segments + 1 ±꣬ i Ϊ data[offsets[i], offsets[i + 1])
+EXPORT int sort_batch(int* data, const int* offsets, int segments, int threads, int options, SortPerformance* stats);
+// з֣ÿ segLength ԪһΣһοԽ϶
+EXPORT int sort_batch_fixed(int* data, int n, int segLength, int threads, int options, SortPerformance* stats);
+
+// ׷ (sort_trace.c)о㷨 (ð ~ ) ¼ÿһ
+// طʱĹؼ֡һ״̬Ҫʷ
+typedef struct {
+    unsigned int head;       //  4 λΪ¼ͣ 28 λΪ± i
+    int arg;                 // Ƚ/± jд룺дֵλ0
+} SortEvent;
+
+enum {
+    SORT_EV_COMPARE = 1,     // Ƚ a[i]  a[j]
+    SORT_EV_SWAP,            //  a[i]  a[j]
+    SORT_EV_WRITE,           // a[i] = arg
+    SORT_EV_PHASE            // λ i ѹλ (ı)
+};
+
+#define SORT_EV_TYPE(e) ((int)((e).head >> 28))
+#define SORT_EV_INDEX(e) ((int)((e).head & 0x0fffffffu))
+
+typedef struct {
+    SortEvent* buffer;       // ÷ṩ¼壻NULL ʱڲ䲢
+    long long capacity;      // ¼ (ʹڲʱ 0 ʾ)
+    int ring;                // 1: д󸲸¼0: дֹͣ¼ (ճ)
+    int compareSample;       // Ƚ¼ÿ compareSample ¼ 1  (<= 1 ȫ¼)/д¼
+    long long keyframeInterval; // ؼ֡ (¼)0 ΪԶ
+} SortTraceOptions;
+
+typedef struct SortTrace SortTrace;
+
+EXPORT void sort_trace_options_init(SortTraceOptions* opt);
+// ԭ arr ¼opt Ϊ NULLstats Ϊ׷ٰļʱΪ NULL
+// ֵ֧㷨Ƿ NULL
+EXPORT SortTrace* sort_trace_run(int algo, int* arr, int n, const SortTraceOptions* opt, SortPerformance* stats);
+EXPORT void sort_trace_free(SortTrace* t);
+// Ѳ¼ (λбǵ) step ֡Ϊִǰ step ¼״̬
+EXPORT long long sort_trace_length(const SortTrace* t);
+// ɻطŵһ֡ (ǻλʱΪ 0)
+EXPORT long long sort_trace_first(const SortTrace* t);
+// д¼¼ǰֹͣʱ 1
+EXPORT int sort_trace_truncated(const SortTrace* t);
+// ȡ index ¼ѱǻԽ緵 -1
+EXPORT int sort_trace_event(const SortTrace* t, long long index, SortEvent* out);
+// ؽ step ֡д out (n )marks  NULL ʱдλǷѹλ
+// ˳򲥷ʱһ֡صؼ֡
+EXPORT int sort_trace_frame(SortTrace* t, long long step, int* out, unsigned char* marks);
+
+//  (sort_typed.c)
+typedef enum {
+    SORT_TYPE_I32 = 0,       // int
+    SORT_TYPE_I64,           // long long
+    SORT_TYPE_U64,           // unsigned long long
+    SORT_TYPE_F32,           // floatNaN 
+    SORT_TYPE_F64,           // doubleNaN 
+    SORT_TYPE_KV64,          // SortKV64 key value ֮ƶ
+    SORT_TYPE_COUNT
+} SortElemType;
+
+typedef struct {
+    long long key;
+    long long value;
+} SortKV64;
+
+//  type ͵ԭ (pdqsortȶ)options ɺ SORT_OPT_FASTstats Ϊ NULLɹ 0
+EXPORT int sort_typed(void* data, int n, int type, int options, SortPerformance* stats);
+// ƶݣֻ index[0..n) д±Уʱԭ± (ͬȶ)
+EXPORT int argsort_typed(const void* data, int n, int type, int options, int* index, SortPerformance* stats);
+
+// ·鲢 (sort_merge.c)
+typedef struct {
+    const int* data;          // е
+    int length;
+} SortSpan;
+
+//  k ϲ out (Ϊ֮ͣص)Ԫذ˳
+// k == 2 ޷֧·ϲðÿԪԼ log2(k) αȽϡ
+// stats Ϊ NULLɹ 0Ƿ -1
+EXPORT int kway_merge(const SortSpan* inputs, int k, int* out, SortPerformance* stats);
+// а棺λз̶֣߳鲢threads <= 0 ȡӲ߳
+EXPORT int parallel_kway_merge(const SortSpan* inputs, int k, int* out, int threads, SortPerformance* stats);
+
+// ⲿ (sort_external.c)ΪıļΪļڴռòԤ
+typedef struct {
+    long long memoryBudget;   // ڴԤ (ֽ)Ĭ 256MBС 1MB
+    const char* tempDir;      // ʱεĿ¼NULL ΪǰĿ¼
+    int fanIn;                // ÿϲĶ (Ĭ 64)ʱȷϲ
+} ExternalSortOptions;
+
+typedef struct {
+    SortPerformance stats;    // compareCount ΪϲȽϴmoveCount ΪдԪpasses Ϊϲ
+    long long elements;       // Ԫ (stats.dataSize ڳ int Χʱض)
+    int runs;                 // ʼȫһװʱΪ 0
+    long long bytesRead;      // ֽ (ʱļ)
+    long long bytesWritten;   // дֽ (ʱļ)
+    double runMs;             // ׶ 1 ʱֿ롢д
+    double sortMs;            // ڴĺʱ
+    double mergeMs;           // ׶ 2 ʱk ·ϲ
+} ExternalSortStats;
+
+EXPORT void external_sort_options_init(ExternalSortOptions* opt);
+// ɹ 0options Ϊ NULL ʱȫȡĬֵstats Ϊ NULL
+// ڶ߳ͬʱãʱļڽΨһ
+EXPORT int external_sort_file(const char* inPath, const char* outPath, const ExternalSortOptions* options,
+    ExternalSortStats* stats);
+
+// ʱ ()׼Եⲿʱʹ
+EXPORT double get_time_ms(void);
+
+// ʱڴ (sort_arena.c)߳УŽ SortContext.arena ɿá
+// 鰴 64 ֽڶ룻һĿ˻ malloc󰴱Զݣ
+// ͬģظӵڶٷ䡣һڴͬһʱֻܸһʹ
+enum {
+    SORT_ARENA_HUGE_PAGES = 0x1,   // Դҳ (Windows ҪڴҳȨޣLinux ʧʱΪ͸ҳ)
+    SORT_ARENA_PREFAULT = 0x2      // ӳȫҳ棬ȱҳ
+};
+
+// SortArenaInfo.hugePages ȡֵ
+enum {
+    SORT_ARENA_HUGE_NONE = 0,
+    SORT_ARENA_HUGE_EXPLICIT = 1,
+    SORT_ARENA_HUGE_TRANSPARENT = 2
+};
+
+typedef struct {
+    long long capacity;      // ǰ (ֽ)
+    long long highWater;     //  (ֽ)
+    long long fallbacks;     // ˻ malloc Ŀ
+    long long grows;         // ӳĴ
+    int hugePages;           // SORT_ARENA_HUGE_*
+} SortArenaInfo;
+
+// bytes ΪʼΪ 0 (һ)ʧܷ NULL
+EXPORT SortArena* sort_arena_create(long long bytes, int flags);
+// Ԥ bytes ֽڣеãʧܷ -1ԭֲ
+EXPORT int sort_arena_reserve(SortArena* a, long long bytes);
+EXPORT void sort_arena_info(const SortArena* a, SortArenaInfo* info);
+EXPORT void sort_arena_destroy(SortArena* a);
+
+// Ӳܼ (sort_hwcount.c)Linux  perf_event_openWindows ֻ߳
+// ֻͳƵ̵߳û̬ȡ (Ȩ޲㡢)  valid вλֵΪ 0
+enum {
+    SORT_HW_CYCLES = 0x1,
+    SORT_HW_INSTRUCTIONS = 0x2,
+    SORT_HW_BRANCH_MISSES = 0x4,
+    SORT_HW_L1D_MISSES = 0x8,
+    SORT_HW_LLC_MISSES = 0x10,
+    SORT_HW_DTLB_MISSES = 0x20
+};
+
+typedef struct {
+    int valid;               // SORT_HW_* λ
+    long long cycles;
+    long long instructions;
+    long long branchMisses;
+    long long l1dMisses;     // L1 ݻδ
+    long long llcMisses;     // ĩδ
+    long long dtlbMisses;    //  TLB δ
+} SortHwCounters;
+
+typedef struct SortHwSession SortHwSession;
+
+// 򿪼 (һδ򿪿ɶ start/stop)ڴ治㷵 NULLʱԷػỰ
+EXPORT SortHwSession* sort_hw_open(void);
+// õļ (SORT_HW_* λ)
+EXPORT int sort_hw_valid(const SortHwSession* s);
+EXPORT void sort_hw_start(SortHwSession* s);
+// ֹͣд start 
+EXPORT void sort_hw_stop(SortHwSession* s, SortHwCounters* out);
+EXPORT void sort_hw_close(SortHwSession* s);
+
+// Ӧ (sort_auto.c)sort_run  SORT_AUTO  auto_sort  O(n/64) Ĳ
+// ٰŲ TimSort /  /  /  / pdqsort ֮ѡ
+// Ųһʹʱӻ SORT_TUNING_FILE ָļ (ĬϵǰĿ¼µ sort_tuning.txt) أ
+// ļĬֵsort_calibrate ڱϲɸļ
+typedef struct {
+    int samples;             // 
+    double runRatio;         // Ƶ / nλ a[i] -> a[i + 1] -> a[i + 2] ıı
+    double descentRatio;     // λ a[i + 1] < a[i] ı ()ӽ 0 Ϊ򣬽ӽ 1 Ϊƽ
+    double duplicateRatio;   // ظֵռ
+    double rangeRatio;       // Ƶֵ (max - min + 1)  n ֮
+    int sampleMin;
+    int sampleMax;
+} SortFeatures;
+
+typedef struct {
+    double runRatio;         // SortFeatures.runRatio ʱ TimSort (򡢽ζ)0 ر
+    double countRatio;       // ʵֵ򲻳 n ĸñʱü ( 8)0 ر
+    double duplicateRatio;   // duplicateRatio ʱû (ظֵʱ pdqsort )
+    int radixMinN;           // Сڸùģʱû0 ر
+    int parallelMinN;        // Сڸùģ߳ 1 ʱò㷨0 ر
+    int parallelAlgo;        // SORT_PARALLEL_MERGE  SORT_PARALLEL_QUICK
+    int calibrated;          // 1 ʾУ׼0 ΪĬֵ
+} SortTuning;
+
+//  arr  (޸)Ƿ -1
+EXPORT int sort_auto_analyze(const int* arr, int n, SortFeatures* f);
+// ǰŲΪ arr ѡ㷨 (SORT_*)threads ͬ SortContext.threads
+EXPORT int sort_auto_choose(const int* arr, int n, int threads);
+
+EXPORT void sort_tuning_defaults(SortTuning* t);
+// ǰЧĲ (Ҫʱȼļ)
+EXPORT void sort_tuning_get(SortTuning* t);
+// 滻ǰҪڽеӦ򲢷
+EXPORT void sort_tuning_set(const SortTuning* t);
+// ȡļ t (ļûеȡĬֵ)ı䵱ǰļڷ -1
+EXPORT int sort_tuning_load(const char* path, SortTuning* t);
+EXPORT int sort_tuning_save(const char* path, const SortTuning* t);
+// У׼ maxN Ϊģ (<= 0 ȡ 1M) Ľ㣬д out (Ϊ NULL) Ч
+// path  NULL ʱͬʱΪļʱΪ뼶ɹ 0
+EXPORT int sort_calibrate(int maxN, const char* path, SortTuning* out);
+
+// 㿪Сʹ SIMD 磬״ʹʱ CPUID ѡָ
+// sort_simd_level صǰָsort_simd_set_level ɰ (ڶԱ)ʵЧļ
+EXPORT int sort_simd_level(void);
+EXPORT int sort_simd_set_level(int level);
+
 #endif // SORT_ENGINE_H
\ No newline at end of file
@@ -0,0 +1,598 @@
+#ifndef _WIN32
+#define _GNU_SOURCE    // fdopen ϸ C ׼ģʽ²
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <share.h>
+#else
+#include <unistd.h>
+#endif
+
+// ⲿݳڴʱʹá
+// ׶ 1 ڴԤֿ룬ûźúдʱΣ
+// ׶ 2 ð k ·ϲʱȺϲɸٵĶΡ
+// д̳߳첽Уÿ黺彻ʹã I/O ص
+
+#define EXT_DEFAULT_BUDGET (256LL << 20)
+#define EXT_MIN_BUDGET (1LL << 20)
+#define EXT_DEFAULT_FANIN 64
+#define EXT_MAX_FANIN 1024
+#define EXT_MIN_BUFFER 1024   // ϲ׶ÿ黺 1024 Ԫ
+
+typedef struct {
+    char path[512];
+    long long count;
+} ExtRun;
+
+typedef struct {
+    const ExternalSortOptions* opt;
+    ExternalSortStats* st;
+    ExtRun* runs;
+    int runCount;
+    int runCapacity;
+} ExtSort;
+
+// ʱαڽȫֵͬһﲢĶⲿʱĿ¼Ҳ
+static volatile long g_runSerial = 0;
+
+// 1. 첽д
+typedef struct {
+    FILE* fp;
+    int* buf;
+    size_t count;      // ĸдҪдĸ
+    size_t done;       // ʵɵĸ
+    PoolTask task;
+} IoJob;
+
+static void read_job(void* arg, int index) {
+    (void)index;
+    IoJob* j = (IoJob*)arg;
+    j->done = fread(j->buf, sizeof(int), j->count, j->fp);
+}
+
+static void write_job(void* arg, int index) {
+    (void)index;
+    IoJob* j = (IoJob*)arg;
+    j->done = fwrite(j->buf, sizeof(int), j->count, j->fp);
+}
+
+// 2. 룺ļ freadıļӳ󰴿
+typedef struct {
+    int binary;
+    FILE* fp;
+    long long left;        // ƣʣԪ
+    IoMap map;             // ı
+    size_t pos;
+    double bytesPerElem;   // ıƽÿֽһķΧ
+    long long bytesRead;
+} ExtReader;
+
+static int reader_open(ExtReader* r, const char* path) {
+    memset(r, 0, sizeof(*r));
+#ifdef _WIN32
+    if (fopen_s(&r->fp, path, "rb") != 0) return -1;
+#else
+    r->fp = fopen(path, "rb");
+    if (!r->fp) return -1;
+#endif
+    SortBinHeader h;
+    if (fread(&h, sizeof(h), 1, r->fp) == 1 && h.magic == SORT_BIN_MAGIC) {
+        if (h.elemType != SORT_BIN_INT32) return -1;
+        r->binary = 1;
+        r->left = (long long)h.count;
+        r->bytesRead = sizeof(h);
+        return 0;
+    }
+    fclose(r->fp);
+    r->fp = NULL;
+    r->bytesPerElem = 8.0;
+    return io_map(&r->map, path, 0);
+}
+
+static void reader_close(ExtReader* r) {
+    if (r->fp) fclose(r->fp);
+    io_unmap(r->map.base, r->map.size);
+    r->fp = NULL;
+    r->map.base = NULL;
+}
+
+// һ飬 cap ظ 0 -1
+static long long reader_fill(ExtReader* r, int* buf, size_t cap) {
+    if (r->binary) {
+        size_t want = (long long)cap < r->left ? cap : (size_t)r->left;
+        size_t got = fread(buf, sizeof(int), want, r->fp);
+        if (got != want) return -1;
+        r->left -= (long long)got;
+        r->bytesRead += (long long)(got * sizeof(int));
+        return (long long)got;
+    }
+
+    const char* base = r->map.base;
+    size_t size = r->map.size;
+    if (r->pos >= size) return 0;
+    // һܶȹƷΧ ( 5% )ʱѷΧ
+    size_t range = (size_t)(cap * r->bytesPerElem * 0.95);
+    if (range < 1) range = 1;
+    for (;;) {
+        size_t end = size - r->pos <= range ? size : io_text_cut(base, size, r->pos + range);
+        long long n = io_parse_text(base + r->pos, base + end, r->pos ? base[r->pos - 1] : 0, buf, cap);
+        if (n >= 0) {
+            if (n > 0) r->bytesPerElem = (double)(end - r->pos) / (double)n;
+            r->bytesRead += (long long)(end - r->pos);
+            r->pos = end;
+            if (n == 0 && end < size) continue;   // ζǷָ
+            return n;
+        }
+        range /= 2;
+    }
+}
+
+typedef struct {
+    ExtReader* reader;
+    int* buf;
+    size_t cap;
+    long long got;
+    PoolTask task;
+} FillJob;
+
+static void fill_job(void* arg, int index) {
+    (void)index;
+    FillJob* j = (FillJob*)arg;
+    j->got = reader_fill(j->reader, j->buf, j->cap);
+}
+
+// 3. ʱļ
+static void remove_runs(ExtSort* es, int from, int to) {
+    for (int i = from; i < to; i++) remove(es->runs[i].path);
+}
+
+static long next_run_serial(void) {
+#ifdef _WIN32
+    return InterlockedIncrement(&g_runSerial);
+#else
+    return __atomic_add_fetch(&g_runSerial, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+// ռļѴ (Ľ) ʱʧܶǸ
+static FILE* create_exclusive(const char* path) {
+#ifdef _WIN32
+    int fd;
+    if (_sopen_s(&fd, path, _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) return NULL;
+    FILE* fp = _fdopen(fd, "wb");
+    if (!fp) _close(fd);
+#else
+    int fd = open(path, O_CREAT | O_EXCL | O_WRONLY, 0600);
+    if (fd < 0) return NULL;
+    FILE* fp = fdopen(fd, "wb");
+    if (!fp) close(fd);
+#endif
+    return fp;
+}
+
+// Ǽһµʱβռļʧܷ NULL
+static FILE* new_run(ExtSort* es, ExtRun** out) {
+    if (es->runCount == es->runCapacity) {
+        int cap = es->runCapacity ? es->runCapacity * 2 : 64;
+        ExtRun* p = (ExtRun*)realloc(es->runs, (size_t)cap * sizeof(ExtRun));
+        if (!p) return NULL;
+        es->runs = p;
+        es->runCapacity = cap;
+    }
+    ExtRun* run = &es->runs[es->runCount];
+#ifdef _WIN32
+    unsigned long pid = (unsigned long)GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long)getpid();
+#endif
+    // űظײͬļֻ pid úһ
+    for (int attempt = 0; attempt < 16; attempt++) {
+        snprintf(run->path, sizeof(run->path), "%s/sortrun_%lu_%ld.tmp",
+            es->opt->tempDir ? es->opt->tempDir : ".", pid, next_run_serial());
+        FILE* fp = create_exclusive(run->path);
+        if (fp) {
+            run->count = 0;
+            es->runCount++;
+            *out = run;
+            return fp;
+        }
+        if (errno != EEXIST) break;
+    }
+    return NULL;
+}
+
+static FILE* open_file(const char* path, const char* mode) {
+#ifdef _WIN32
+    FILE* fp = NULL;
+    if (fopen_s(&fp, path, mode) != 0) return NULL;
+    return fp;
+#else
+    return fopen(path, mode);
+#endif
+}
+
+static FILE* open_output(const char* path, long long count) {
+    FILE* fp = open_file(path, "wb");
+    if (!fp) return NULL;
+    SortBinHeader h;
+    h.magic = SORT_BIN_MAGIC;
+    h.elemType = SORT_BIN_INT32;
+    h.count = (unsigned long long)count;
+    if (fwrite(&h, sizeof(h), 1, fp) != 1) {
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
+}
+
+// 4. ׶ 1
+// 黺彻棺ǰʱһں̨롢һں̨д
+static int write_output(const char* path, const int* arr, long long n, ExternalSortStats* st) {
+    FILE* out = open_output(path, n);
+    if (!out) return -1;
+    size_t done = fwrite(arr, sizeof(int), (size_t)n, out);
+    if (fclose(out) != 0 || done != (size_t)n) return -1;
+    st->bytesWritten += (long long)(sizeof(SortBinHeader) + (size_t)n * sizeof(int));
+    st->stats.moveCount += n;
+    return 0;
+}
+
+static int make_runs(ExtSort* es, ExtReader* reader, size_t chunk, const char* outPath) {
+    ExternalSortStats* st = es->st;
+    int* buf[2];
+    buf[0] = (int*)malloc(chunk * sizeof(int));
+    buf[1] = (int*)malloc(chunk * sizeof(int));
+    if (!buf[0] || !buf[1]) {
+        free(buf[0]); free(buf[1]);
+        return -1;
+    }
+
+    FillJob fill;
+    IoJob write;
+    FILE* runFile = NULL;
+    int filling = 0, writing = 0, cur = 0, result = 0;
+    fill.reader = reader;
+    fill.cap = chunk;
+    fill.buf = buf[0];
+    fill_job(&fill, 0);
+    if (fill.got == 0) result = write_output(outPath, buf[0], 0, st);   // 
+
+    while (result == 0 && fill.got > 0) {
+        long long n = fill.got;
+        // һд꣬һ黺һ
+        if (writing) {
+            pool_wait(&write.task);
+            writing = 0;
+            fclose(runFile);
+            runFile = NULL;
+            if (write.done != write.count) { result = -1; break; }
+        }
+        fill.buf = buf[cur ^ 1];
+        pool_submit(&fill.task, fill_job, &fill);
+        filling = 1;
+
+        double t = get_time_ms();
+        _RadixSortFast(buf[cur], (int)n);
+        st->sortMs += get_time_ms() - t;
+        st->elements += n;
+
+        // һȫݣֱдʱļ
+        if (es->runCount == 0) {
+            pool_wait(&fill.task);
+            filling = 0;
+            if (fill.got == 0) {
+                result = write_output(outPath, buf[cur], n, st);
+                break;
+            }
+        }
+
+        ExtRun* run;
+        runFile = new_run(es, &run);
+        if (!runFile) { result = -1; break; }
+        run->count = n;
+        st->bytesWritten += n * (long long)sizeof(int);
+        st->stats.moveCount += n;
+        write.fp = runFile;
+        write.buf = buf[cur];
+        write.count = (size_t)n;
+        pool_submit(&write.task, write_job, &write);
+        writing = 1;
+
+        if (filling) {
+            pool_wait(&fill.task);
+            filling = 0;
+        }
+        cur ^= 1;
+    }
+
+    if (filling) pool_wait(&fill.task);
+    if (writing) {
+        pool_wait(&write.task);
+        if (write.done != write.count) result = -1;
+    }
+    if (runFile) fclose(runFile);
+    if (fill.got < 0) result = -1;
+    free(buf[0]);
+    free(buf[1]);
+    return result;
+}
+
+// 5. ׶ 2 k ·ϲ
+typedef struct {
+    FILE* fp;
+    int* buf[2];
+    int cur;
+    size_t pos;
+    size_t len;
+    long long left;    // ļδύȡԪ
+    int reading;       // һ黺ǷнеĶȡ
+    int done;
+    IoJob job;
+} RunReader;
+
+typedef struct {
+    RunReader* in;
+    int k;
+    int* tree;         // tree[0] Ϊǰʤߣtree[1..k-1] Ϊڲİ
+    long long cmp;
+} LoserTree;
+
+//  a ĵǰԪǷ b Ϊʱ±С
+static int lt_before(LoserTree* lt, int a, int b) {
+    RunReader* x = &lt->in[a];
+    RunReader* y = &lt->in[b];
+    if (x->done) return 0;
+    if (y->done) return 1;
+    int va = x->buf[x->cur][x->pos], vb = y->buf[y->cur][y->pos];
+    lt->cmp++;
+    return va < vb || (va == vb && a < b);
+}
+
+static void lt_build(LoserTree* lt, int* win) {
+    int k = lt->k;
+    for (int i = 0; i < k; i++) win[k + i] = i;
+    for (int i = k - 1; i >= 1; i--) {
+        int a = win[2 * i], b = win[2 * i + 1];
+        if (lt_before(lt, b, a)) { win[i] = b; lt->tree[i] = a; }
+        else { win[i] = a; lt->tree[i] = b; }
+    }
+    lt->tree[0] = k > 1 ? win[1] : 0;
+}
+
+// ʤǰһԪغҶһΣԼ log2(k) αȽ
+static void lt_replay(LoserTree* lt) {
+    int w = lt->tree[0];
+    for (int node = (w + lt->k) >> 1; node >= 1; node >>= 1) {
+        if (lt_before(lt, lt->tree[node], w)) {
+            int t = lt->tree[node];
+            lt->tree[node] = w;
+            w = t;
+        }
+    }
+    lt->tree[0] = w;
+}
+
+static void reader_request(RunReader* r, size_t bufElems) {
+    if (r->left <= 0) return;
+    r->job.fp = r->fp;
+    r->job.buf = r->buf[r->cur ^ 1];
+    r->job.count = (long long)bufElems < r->left ? bufElems : (size_t)r->left;
+    r->left -= (long long)r->job.count;
+    r->reading = 1;
+    pool_submit(&r->job.task, read_job, &r->job);
+}
+
+// ǰ꣺̨õǿ飬Ϊύһζȡ
+static int reader_advance(RunReader* r, size_t bufElems, ExternalSortStats* st) {
+    if (++r->pos < r->len) return 0;
+    if (!r->reading) {
+        r->done = 1;
+        return 0;
+    }
+    pool_wait(&r->job.task);
+    r->reading = 0;
+    if (r->job.done != r->job.count) return -1;
+    st->bytesRead += (long long)(r->job.done * sizeof(int));
+    r->cur ^= 1;
+    r->pos = 0;
+    r->len = r->job.done;
+    reader_request(r, bufElems);
+    return 0;
+}
+
+// ϲ runs[0..k) д out (дļͷʱֱ׷)
+static int merge_runs(ExtSort* es, const ExtRun* runs, int k, FILE* out, size_t bufElems) {
+    ExternalSortStats* st = es->st;
+    RunReader* in = (RunReader*)calloc((size_t)k, sizeof(RunReader));
+    int* tree = (int*)malloc((size_t)(3 * k) * sizeof(int));   //  k + õ 2k
+    int* outBuf[2];
+    outBuf[0] = (int*)malloc(bufElems * sizeof(int));
+    outBuf[1] = (int*)malloc(bufElems * sizeof(int));
+    int result = 0;
+    if (!in || !tree || !outBuf[0] || !outBuf[1]) { result = -1; goto cleanup; }
+
+    for (int i = 0; i < k && result == 0; i++) {
+        RunReader* r = &in[i];
+        r->fp = open_file(runs[i].path, "rb");
+        r->buf[0] = (int*)malloc(bufElems * sizeof(int));
+        r->buf[1] = (int*)malloc(bufElems * sizeof(int));
+        if (!r->fp || !r->buf[0] || !r->buf[1]) { result = -1; break; }
+        r->left = runs[i].count;
+        // һͬ룬ڶں̨Ԥ
+        r->cur = 1;
+        reader_request(r, bufElems);
+        r->len = 0;
+        r->pos = (size_t)-1;
+        if (reader_advance(r, bufElems, st) != 0) result = -1;
+    }
+    if (result != 0) goto cleanup;
+
+    LoserTree lt;
+    lt.in = in;
+    lt.k = k;
+    lt.tree = tree;
+    lt.cmp = 0;
+    lt_build(&lt, tree + k);
+
+    IoJob write;
+    int writing = 0, oc = 0;
+    size_t on = 0;
+    for (;;) {
+        int w = tree[0];
+        RunReader* r = &in[w];
+        if (r->done) break;
+        outBuf[oc][on++] = r->buf[r->cur][r->pos];
+        if (on == bufElems) {
+            if (writing) {
+                pool_wait(&write.task);
+                if (write.done != write.count) { result = -1; writing = 0; break; }
+            }
+            write.fp = out;
+            write.buf = outBuf[oc];
+            write.count = on;
+            pool_submit(&write.task, write_job, &write);
+            writing = 1;
+            st->bytesWritten += (long long)(on * sizeof(int));
+            st->stats.moveCount += (long long)on;
+            oc ^= 1;
+            on = 0;
+        }
+        if (reader_advance(r, bufElems, st) != 0) { result = -1; break; }
+        lt_replay(&lt);
+    }
+    if (writing) {
+        pool_wait(&write.task);
+        if (write.done != write.count) result = -1;
+    }
+    if (result == 0 && on > 0) {
+        if (fwrite(outBuf[oc], sizeof(int), on, out) != on) result = -1;
+        st->bytesWritten += (long long)(on * sizeof(int));
+        st->stats.moveCount += (long long)on;
+    }
+    st->stats.compareCount += lt.cmp;
+
+cleanup:
+    if (in) {
+        for (int i = 0; i < k; i++) {
+            if (in[i].reading) pool_wait(&in[i].job.task);
+            if (in[i].fp) fclose(in[i].fp);
+            free(in[i].buf[0]);
+            free(in[i].buf[1]);
+        }
+    }
+    free(in);
+    free(tree);
+    free(outBuf[0]);
+    free(outBuf[1]);
+    return result;
+}
+
+// 6. ӿ
+EXPORT void external_sort_options_init(ExternalSortOptions* opt) {
+    if (!opt) return;
+    opt->memoryBudget = EXT_DEFAULT_BUDGET;
+    opt->tempDir = NULL;
+    opt->fanIn = EXT_DEFAULT_FANIN;
+}
+
+EXPORT int external_sort_file(const char* inPath, const char* outPath, const ExternalSortOptions* options,
+    ExternalSortStats* stats) {
+    if (!inPath || !outPath) return -1;
+    ExternalSortOptions opt;
+    external_sort_options_init(&opt);
+    if (options) {
+        if (options->memoryBudget > 0) opt.memoryBudget = options->memoryBudget;
+        if (options->fanIn >= 2) opt.fanIn = options->fanIn;
+        opt.tempDir = options->tempDir;
+    }
+    if (opt.memoryBudget < EXT_MIN_BUDGET) opt.memoryBudget = EXT_MIN_BUDGET;
+    if (opt.fanIn > EXT_MAX_FANIN) opt.fanIn = EXT_MAX_FANIN;
+
+    ExternalSortStats local;
+    ExternalSortStats* st = stats ? stats : &local;
+    memset(st, 0, sizeof(*st));
+    snprintf(st->stats.algorithm, sizeof(st->stats.algorithm), "External Sort");
+
+    ExtSort es;
+    memset(&es, 0, sizeof(es));
+    es.opt = &opt;
+    es.st = st;
+
+    ExtReader reader;
+    if (reader_open(&reader, inPath) != 0) {
+        reader_close(&reader);
+        return -1;
+    }
+
+    // ׶ 1д + ʱ飬
+    double t0 = get_time_ms();
+    long long chunk = opt.memoryBudget / (3 * (long long)sizeof(int));
+    if (chunk > 0x7fffffff) chunk = 0x7fffffff;
+    int result = make_runs(&es, &reader, (size_t)chunk, outPath);
+    st->bytesRead += reader.bytesRead;
+    reader_close(&reader);
+    double t1 = get_time_ms();
+    st->runMs = t1 - t0;
+    st->runs = es.runCount;
+
+    // ׶ 2ʱϲ¶Σһֱд
+    while (result == 0 && es.runCount > 0) {
+        int groupCount = es.runCount <= opt.fanIn ? 1 : (es.runCount + opt.fanIn - 1) / opt.fanIn;
+        int k = es.runCount < opt.fanIn ? es.runCount : opt.fanIn;
+        // ÿ黺
+        long long bufElems = opt.memoryBudget / (long long)sizeof(int) / (2 * (k + 1));
+        if (bufElems < EXT_MIN_BUFFER) bufElems = EXT_MIN_BUFFER;
+        st->stats.passes++;
+
+        if (groupCount == 1) {
+            long long total = 0;
+            for (int i = 0; i < es.runCount; i++) total += es.runs[i].count;
+            FILE* out = open_output(outPath, total);
+            if (!out) { result = -1; break; }
+            st->bytesWritten += sizeof(SortBinHeader);
+            result = merge_runs(&es, es.runs, es.runCount, out, (size_t)bufElems);
+            if (fclose(out) != 0) result = -1;
+            remove_runs(&es, 0, es.runCount);
+            es.runCount = 0;
+            break;
+        }
+
+        int oldCount = es.runCount;
+        ExtRun* old = (ExtRun*)malloc((size_t)oldCount * sizeof(ExtRun));
+        if (!old) { result = -1; break; }
+        memcpy(old, es.runs, (size_t)oldCount * sizeof(ExtRun));
+        es.runCount = 0;
+        for (int g = 0; g < oldCount && result == 0; g += opt.fanIn) {
+            int n = oldCount - g < opt.fanIn ? oldCount - g : opt.fanIn;
+            ExtRun* run;
+            FILE* out = new_run(&es, &run);
+            if (!out) { result = -1; break; }
+            for (int i = 0; i < n; i++) run->count += old[g + i].count;
+            result = merge_runs(&es, old + g, n, out, (size_t)bufElems);
+            if (fclose(out) != 0) result = -1;
+            for (int i = 0; i < n; i++) remove(old[g + i].path);
+        }
+        if (result != 0) {
+            for (int i = 0; i < oldCount; i++) remove(old[i].path);
+        }
+        free(old);
+    }
+    if (result != 0) remove_runs(&es, 0, es.runCount);
+    free(es.runs);
+
+    double t2 = get_time_ms();
+    st->mergeMs = t2 - t1;
+    st->stats.timeCost = t2 - t0;
+    st->stats.dataSize = st->elements > 0x7fffffff ? 0x7fffffff : (int)st->elements;
+    return result;
+}
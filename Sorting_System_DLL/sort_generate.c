@@ -0,0 +1,191 @@
+#include "sort_internal.h"
+#include <math.h>
+#include <stdlib.h>
+
+// ɣPCG32 αʽӣзֲ O(n)
+// 鰴̶ȷֿ飬ÿʹ (, ) Ķ
+// ˽ֻȡӣ߳޹أԷĲ䡣
+
+#define GEN_BLOCK 65536          // ÿԪҲǲ
+#define GEN_PAR_MIN (4 * GEN_BLOCK)
+
+// 1. PCG32 (O'Neill, pcg-random.org Сʵ)
+typedef struct {
+    unsigned long long state;
+    unsigned long long inc;
+} Pcg32;
+
+static unsigned pcg32_next(Pcg32* r) {
+    unsigned long long old = r->state;
+    r->state = old * 6364136223846793005ULL + r->inc;
+    unsigned xorshifted = (unsigned)(((old >> 18u) ^ old) >> 27u);
+    unsigned rot = (unsigned)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+static void pcg32_seed(Pcg32* r, unsigned long long seed, unsigned long long stream) {
+    r->state = 0;
+    r->inc = (stream << 1u) | 1u;
+    pcg32_next(r);
+    r->state += seed;
+    pcg32_next(r);
+}
+
+// [0, bound) ڵ (˷ȡλƫɺ)
+static int pcg32_below(Pcg32* r, unsigned bound) {
+    return (int)(((unsigned long long)pcg32_next(r) * bound) >> 32);
+}
+
+// (0, 1] ڵĸ
+static double pcg32_unit(Pcg32* r) {
+    return ((double)pcg32_next(r) + 1.0) / 4294967296.0;
+}
+
+// 2. Zipf ֲܾ-ݲ (Hormann & Derflinger)ÿ O(1)
+typedef struct {
+    double s;                // ָ
+    int count;               // ȡֵΪ 1..count
+    double hX1;              // H(1.5) - 1
+    double hN;               // H(count + 0.5)
+    double sVal;
+} ZipfParams;
+
+static double zipf_helper1(double x) {   // log1p(x) / x
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+static double zipf_helper2(double x) {   // expm1(x) / x
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+static double zipf_h(const ZipfParams* z, double x) {
+    return exp(-z->s * log(x));
+}
+
+static double zipf_hIntegral(const ZipfParams* z, double x) {
+    double lx = log(x);
+    return zipf_helper2((1.0 - z->s) * lx) * lx;
+}
+
+static double zipf_hIntegralInverse(const ZipfParams* z, double x) {
+    double t = x * (1.0 - z->s);
+    if (t < -1.0) t = -1.0;
+    return exp(zipf_helper1(t) * x);
+}
+
+static void zipf_init(ZipfParams* z, int count, double s) {
+    z->s = s;
+    z->count = count;
+    z->hX1 = zipf_hIntegral(z, 1.5) - 1.0;
+    z->hN = zipf_hIntegral(z, count + 0.5);
+    z->sVal = 2.0 - zipf_hIntegralInverse(z, zipf_hIntegral(z, 2.5) - zipf_h(z, 2.0));
+}
+
+static int zipf_sample(const ZipfParams* z, Pcg32* r) {
+    for (;;) {
+        double u = z->hN + pcg32_unit(r) * (z->hX1 - z->hN);
+        double x = zipf_hIntegralInverse(z, u);
+        double k = floor(x + 0.5);
+        if (k < 1.0) k = 1.0;
+        else if (k > z->count) k = z->count;
+        if (k - x <= z->sVal || u >= zipf_hIntegral(z, k + 0.5) - zipf_h(z, k)) return (int)k;
+    }
+}
+
+// 3. ֿ
+typedef struct {
+    int* arr;
+    int n;
+    int type;
+    unsigned long long seed;
+    unsigned maxValue;       // ȡֵϽ ()
+    int param;               // ֲԼĲѻΪĬֵ
+    ZipfParams zipf;
+} GenJob;
+
+static void gen_block(void* arg, int block) {
+    GenJob* job = (GenJob*)arg;
+    int begin = block * GEN_BLOCK;
+    int end = begin + GEN_BLOCK < job->n ? begin + GEN_BLOCK : job->n;
+    int* arr = job->arr;
+    Pcg32 r;
+    pcg32_seed(&r, job->seed, (unsigned long long)block);
+
+    switch (job->type) {
+    case GEN_FEW_UNIQUE: {
+        unsigned step = job->maxValue / (unsigned)job->param;
+        if (step == 0) step = 1;
+        for (int i = begin; i < end; i++) arr[i] = (int)(step * (unsigned)pcg32_below(&r, (unsigned)job->param));
+        break;
+    }
+    case GEN_ORGAN_PIPE:
+        for (int i = begin; i < end; i++) arr[i] = i < (job->n + 1) / 2 ? i : job->n - 1 - i;
+        break;
+    case GEN_SAWTOOTH: {
+        int period = (job->n + job->param - 1) / job->param;
+        for (int i = begin; i < end; i++) arr[i] = i % period;
+        break;
+    }
+    case GEN_ZIPF:
+        for (int i = begin; i < end; i++) arr[i] = zipf_sample(&job->zipf, &r);
+        break;
+    case GEN_FULL_RANGE:
+        for (int i = begin; i < end; i++) arr[i] = (int)pcg32_next(&r);
+        break;
+    default:   // 򡢽ӽȾȡֵ
+        for (int i = begin; i < end; i++) arr[i] = pcg32_below(&r, job->maxValue);
+        break;
+    }
+}
+
+// 4. ӿ
+EXPORT int generate_data_ex(int* arr, int n, int type, unsigned long long seed, int param, int maxValue) {
+    if ((!arr && n > 0) || n < 0 || type < 0 || type >= GEN_DIST_COUNT) return -1;
+    if (n == 0) return 0;
+
+    GenJob job;
+    job.arr = arr;
+    job.n = n;
+    job.type = type;
+    job.seed = seed;
+    job.maxValue = maxValue > 0 ? (unsigned)maxValue : 0x7FFFFFFFu;
+    job.param = param;
+    switch (type) {
+    case GEN_NEARLY_SORTED: if (job.param <= 0) job.param = 1; break;    //  (%)
+    case GEN_FEW_UNIQUE: if (job.param <= 0) job.param = 10; break;      // ֵͬ
+    case GEN_SAWTOOTH: if (job.param <= 0) job.param = 8; break;         // 
+    case GEN_ZIPF:                                                        // ָ x100
+        if (job.param <= 0) job.param = 100;
+        zipf_init(&job.zipf, n, job.param / 100.0);
+        break;
+    default: break;
+    }
+
+    int blocks = (n + GEN_BLOCK - 1) / GEN_BLOCK;
+    pool_parallel_for(blocks, n >= GEN_PAR_MIN ? pool_hardware_threads() : 1, gen_block, &job);
+
+    // ֲ O(n) źãð
+    if (type == GEN_SORTED || type == GEN_REVERSE || type == GEN_NEARLY_SORTED) {
+        _RadixSortFast(arr, n);
+    }
+    if (type == GEN_REVERSE) {
+        for (int i = 0, j = n - 1; i < j; i++, j--) { int t = arr[i]; arr[i] = arr[j]; arr[j] = t; }
+    }
+    if (type == GEN_NEARLY_SORTED && n > 1) {
+        //  n * k% Ԫأʹÿ֮Ķ
+        Pcg32 r;
+        pcg32_seed(&r, seed, (unsigned long long)blocks);
+        long long swaps = (long long)n * job.param / 100;
+        for (long long s = 0; s < swaps; s++) {
+            int i = pcg32_below(&r, (unsigned)n);
+            int j = pcg32_below(&r, (unsigned)n);
+            int t = arr[i]; arr[i] = arr[j]; arr[j] = t;
+        }
+    }
+    return 0;
+}
+
+// ɽӿڣԵǰʱΪӣȡֵ [0, 10000)
+EXPORT void generate_data_c(int* arr, int n, int type) {
+    generate_data_ex(arr, n, type, (unsigned long long)(get_time_ms() * 1000.0), 0, 10000);
+}
@@ -0,0 +1,134 @@
+#ifdef __linux__
+#define _GNU_SOURCE    // syscall() ϸ C ׼ģʽ²
+#endif
+#include "sort_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+// ӲܼΧһȡڡָ֧Ԥʧ L1D/LLC/dTLB δС
+// Linux ÿ¼ perf_event_open ֻû̬飬ĳһ򲻿 ( seccomp
+// perf_event_paranoidû PMU) ʱճȱ valid вλ
+// Windows û̬ò PMUֻе̵߳ (QueryThreadCycleTime)
+// ֻǵ̣߳㷨Ĺ̲߳롣
+
+#define HW_EVENT_COUNT 6
+
+struct SortHwSession {
+#ifdef __linux__
+    int fd[HW_EVENT_COUNT];
+#elif defined(_WIN32)
+    ULONG64 startCycles;
+#endif
+    int valid;
+};
+
+#ifdef __linux__
+#define HW_CACHE_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+// ± SORT_HW_* λһ
+static const struct {
+    unsigned int type;
+    unsigned long long config;
+} g_hwEvents[HW_EVENT_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_HW_CACHE, HW_CACHE_MISS(PERF_COUNT_HW_CACHE_L1D) },
+    { PERF_TYPE_HW_CACHE, HW_CACHE_MISS(PERF_COUNT_HW_CACHE_LL) },
+    { PERF_TYPE_HW_CACHE, HW_CACHE_MISS(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+static int hw_open_event(int index) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = g_hwEvents[index].type;
+    attr.config = g_hwEvents[index].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Ӳλʱں˷ʱãʱڰԭ
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+EXPORT SortHwSession* sort_hw_open(void) {
+    SortHwSession* s = (SortHwSession*)calloc(1, sizeof(SortHwSession));
+    if (!s) return NULL;
+#ifdef __linux__
+    for (int i = 0; i < HW_EVENT_COUNT; i++) {
+        s->fd[i] = hw_open_event(i);
+        if (s->fd[i] >= 0) s->valid |= 1 << i;
+    }
+#elif defined(_WIN32)
+    ULONG64 cycles;
+    if (QueryThreadCycleTime(GetCurrentThread(), &cycles)) s->valid = SORT_HW_CYCLES;
+#endif
+    return s;
+}
+
+EXPORT int sort_hw_valid(const SortHwSession* s) {
+    return s ? s->valid : 0;
+}
+
+EXPORT void sort_hw_start(SortHwSession* s) {
+    if (!s) return;
+#ifdef __linux__
+    for (int i = 0; i < HW_EVENT_COUNT; i++) {
+        if (s->fd[i] < 0) continue;
+        ioctl(s->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(s->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#elif defined(_WIN32)
+    if (s->valid) QueryThreadCycleTime(GetCurrentThread(), &s->startCycles);
+#endif
+}
+
+EXPORT void sort_hw_stop(SortHwSession* s, SortHwCounters* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!s) return;
+    long long* value[HW_EVENT_COUNT] = {
+        &out->cycles, &out->instructions, &out->branchMisses, &out->l1dMisses, &out->llcMisses, &out->dtlbMisses,
+    };
+#ifdef __linux__
+    for (int i = 0; i < HW_EVENT_COUNT; i++) {
+        if (s->fd[i] >= 0) ioctl(s->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < HW_EVENT_COUNT; i++) {
+        unsigned long long buf[3];   // ֵʱ䡢ʵʱ
+        if (s->fd[i] < 0 || read(s->fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[2] == 0) continue;
+        double scale = buf[2] < buf[1] ? (double)buf[1] / buf[2] : 1.0;
+        *value[i] = (long long)(buf[0] * scale);
+        out->valid |= 1 << i;
+    }
+#elif defined(_WIN32)
+    ULONG64 end;
+    if (s->valid && QueryThreadCycleTime(GetCurrentThread(), &end)) {
+        *value[0] = (long long)(end - s->startCycles);
+        out->valid = SORT_HW_CYCLES;
+    }
+#else
+    (void)value;
+#endif
+}
+
+EXPORT void sort_hw_close(SortHwSession* s) {
+    if (!s) return;
+#ifdef __linux__
+    for (int i = 0; i < HW_EVENT_COUNT; i++) {
+        if (s->fd[i] >= 0) close(s->fd[i]);
+    }
+#endif
+    free(s);
+}
@@ -0,0 +1,137 @@
+#ifndef SORT_INTERNAL_H
+#define SORT_INTERNAL_H
+
+// ڲ ()
+
+#include "sort_engine.h"
+#include <stddef.h>
+
+#ifdef _MSC_VER
+#define SORT_TLS __declspec(thread)
+#else
+#define SORT_TLS __thread
+#endif
+
+// 1. ֲ߳̾ (sort_engine.c)
+
+// ȡǰ̵߳ļ
+void stats_take(long long* cmp, long long* moves);
+// ۼӵǰ̵߳ļ
+void stats_add(long long cmp, long long moves);
+
+// 2. ̳߳ (sort_thread.c)
+
+#define POOL_MAX_THREADS 256
+
+// Ӳ߳
+int pool_hardware_threads(void);
+// ִ func(arg, 0..count-1)߳ҲִУͬʱʹ threads ̡߳
+// ǰѹ̲߳ļ̣߳˼ں˿ֱʹá
+void pool_parallel_for(int count, int threads, void (*func)(void* arg, int index), void* arg);
+
+// 첽pool_submit  func(arg, 0) ̺߳أpool_wait ȴ
+// ÿ submit Ӧһ waitȴʱδʼɵֱִ߳
+typedef struct {
+    void* job;
+} PoolTask;
+
+int pool_submit(PoolTask* task, void (*func)(void* arg, int index), void* arg);
+void pool_wait(PoolTask* task);
+
+// ȡȣÿ߳ӵһ˫˶УԼӶȡ̴߳ӱ˶еײȡ
+// roots ʼ 0 ̵߳ĶУprocess һ [low, high]
+// ڼ ws_push ѲŻԼĶС䴦󷵻ء
+typedef struct {
+    int low;
+    int high;
+} WsRange;
+
+typedef struct WsWorker WsWorker;
+
+void pool_work_stealing(int threads, const WsRange roots[], int rootCount,
+    void (*process)(void* arg, WsWorker* self, int low, int high), void* arg);
+void ws_push(WsWorker* self, int low, int high);
+
+// 3. 㷨
+
+// й鲢һˣ src гΪ width 鲢 dst
+// Ϊ pieces ݣÿһ
+typedef struct {
+    const int* src;
+    int* dst;
+    int n;
+    int width;
+    int pieces;
+} MergePass;
+
+// л֣ pivot  src ֳ С// д dst
+typedef struct {
+    const int* src;
+    int* dst;
+    int n;
+    int pieces;
+    int pivot;
+    int* counts;   // ÿ 3 ɨдΪ÷θԵд
+} PartitionPass;
+
+// 4. С (sort_simd.c)
+
+#define SIMD_NET_MAX 64
+
+//  a[0..n)n <= SIMD_NET_MAXǰָѡ SSE4.1/AVX2/AVX-512 ʵ
+void simd_network_sort(int* a, int n);
+
+// 5. ģֱӵõں (sort_engine.c)
+
+void _RadixSortFast(int arr[], int n);
+void _PdqSort(int arr[], int n);
+void _PdqSortFast(int arr[], int n);
+
+// pdqsort  (sort_kernels_pdq.h ĸʵ)
+#define PDQ_INSERTION 24     // pdqsort Сڴ˳ȵò
+#define PDQ_NINTHER 128      // ڴ˳ȵþȡ
+#define PDQ_PARTIAL_LIMIT 8  // ""жƶ
+#define PDQ_BLOCK 64         // 黮ֵĿ鳤 (ƫ unsigned char )
+
+// 6. ļ (sort_io.c)
+
+typedef struct {
+    char* base;
+    size_t size;
+} IoMap;
+
+// ӳļmode: 0 ֻ1 дʱ (Ķдļ)2 д (Ķдļ)
+// ļɹ base Ϊ NULL
+int io_map(IoMap* m, const char* path, int mode);
+void io_unmap(char* base, size_t size);
+// ı [begin, end) е outprev Ϊ begin ǰһֽ (ûΪ 0)end ж֡
+// ظ capacity  -1
+long long io_parse_text(const char* begin, const char* end, char prev, int* out, size_t capacity);
+//  pos ִؿ԰ȫзֵλ
+size_t io_text_cut(const char* base, size_t size, size_t pos);
+
+// 7. ׷ (sort_trace.c / sort_engine.c)
+
+// ׷ٰں˵ĹӣԪָ뻻±¼ڵǰ¼ڵָ (ʱ) 
+void trace_emit(int type, const int* p, const int* q);
+// ׷ٰں㷨ʱд stats㷨û׷ٰ淵 -1
+int sort_run_traced(int algo, int* arr, int n, SortPerformance* stats);
+
+// 8. ʱڴ (sort_arena.c)
+
+// ӳг 64 ֽڶĿ飻 NULL (÷˻ malloc)Լ뱾
+void* arena_alloc(SortArena* a, size_t bytes);
+int arena_owns(const SortArena* a, const void* p);
+// һ黹ȫ飬󳬹ʱ
+void arena_end_run(SortArena* a);
+
+// 9. Ӧ (sort_auto.c)
+
+//  (sort_kernels_radix.h Ӧѡ)
+#define COUNTING_MAX_RATIO 8       // ֵԪ֮
+#define COUNTING_MIN_RANGE 65536   // ֵ򲻳ʱǻ
+
+// sort_run  SORT_AUTOѡͬһִУstats.algorithm ¼ѡ
+int auto_dispatch(SortContext* ctx, int* arr, int n);
+
+#endif // SORT_INTERNAL_H
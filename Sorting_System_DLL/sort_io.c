@@ -0,0 +1,407 @@
+#ifndef _WIN32
+#define _GNU_SOURCE    // madvise/MADV_SEQUENTIAL ϸ C ׼ģʽ²
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define IO_SSE2 1
+#include <emmintrin.h>
+#else
+#define IO_SSE2 0
+#endif
+
+// ļдıļڴӳ˽ļֱӳΪ顣
+// ı 64 ֽΪһ飬 SIMD һεõ"Ƿ"λͼ
+// ٰλͼȡÿִֽڵķָжϲٳڲѭ
+
+#define IO_BLOCK 64
+#define IO_PAR_MIN (4 << 20)     // ı 4MB ʱ߳̽
+
+// 1. ļӳ
+int io_map(IoMap* m, const char* path, int mode) {
+    m->base = NULL;
+    m->size = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, mode == 2 ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return -1;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (unsigned long long)size.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return -1;
+    }
+    m->size = (size_t)size.QuadPart;
+    if (m->size == 0) {
+        CloseHandle(file);
+        return 0;
+    }
+    DWORD protect = mode == 0 ? PAGE_READONLY : (mode == 1 ? PAGE_WRITECOPY : PAGE_READWRITE);
+    DWORD access = mode == 0 ? FILE_MAP_READ : (mode == 1 ? FILE_MAP_COPY : FILE_MAP_WRITE);
+    HANDLE mapping = CreateFileMappingA(file, NULL, protect, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return -1;
+    // ͼᱣӳر
+    m->base = (char*)MapViewOfFile(mapping, access, 0, 0, 0);
+    CloseHandle(mapping);
+    return m->base ? 0 : -1;
+#else
+    int fd = open(path, mode == 2 ? O_RDWR : O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (unsigned long long)st.st_size > (size_t)-1) {
+        close(fd);
+        return -1;
+    }
+    m->size = (size_t)st.st_size;
+    if (m->size == 0) {
+        close(fd);
+        return 0;
+    }
+    int prot = mode == 0 ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* p = mmap(NULL, m->size, prot, mode == 2 ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return -1;
+    if (mode == 0) madvise(p, m->size, MADV_SEQUENTIAL);
+    m->base = (char*)p;
+    return 0;
+#endif
+}
+
+void io_unmap(char* base, size_t size) {
+    if (!base) return;
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+// 2. λͼ i λʾ p[i] ǷΪ '0'..'9'
+static unsigned long long digit_mask(const char* p) {
+#if IO_SSE2
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    unsigned long long mask = 0;
+    for (int i = 0; i < IO_BLOCK; i += 16) {
+        __m128i d = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)(p + i)), zero);
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);   // ޷ d <= 9
+        mask |= (unsigned long long)(unsigned)_mm_movemask_epi8(isDigit) << i;
+    }
+    return mask;
+#else
+    unsigned long long mask = 0;
+    for (int i = 0; i < IO_BLOCK; i++) mask |= (unsigned long long)((unsigned char)(p[i] - '0') < 10) << i;
+    return mask;
+#endif
+}
+
+static int lowest_bit(unsigned long long x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (int)idx;
+#elif defined(_MSC_VER)
+    unsigned long idx;
+    if (_BitScanForward(&idx, (unsigned long)x)) return (int)idx;
+    _BitScanForward(&idx, (unsigned long)(x >> 32));
+    return (int)idx + 32;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// 3. ı
+// ִΪ '0'..'9'ŵǰһֽ '-' ʱȡֽڶΪָ
+// ԭ fscanf 汾 "1,2 3\n-4" Ľһ¡ int Χ 32 λضϡ
+
+// 壬ʱ 1.5 fixed Ϊ 1 ʱǵߵĶ壬дʧ
+typedef struct {
+    int* data;
+    size_t count;
+    size_t capacity;
+    int fixed;
+    int failed;
+} IoVec;
+
+static void vec_push(IoVec* v, unsigned long long x) {
+    if (v->count == v->capacity) {
+        if (v->fixed) { v->failed = 1; return; }
+        size_t cap = v->capacity < 1024 ? 1024 : v->capacity + v->capacity / 2;
+        int* p = (int*)realloc(v->data, cap * sizeof(int));
+        if (!p) { v->failed = 1; return; }
+        v->data = p;
+        v->capacity = cap;
+    }
+    v->data[v->count++] = (int)(unsigned)x;
+}
+
+typedef struct {
+    unsigned long long value;   // δ (޷㣬ʱȻض)
+    int negative;
+    int pending;
+    char prev;         // һһֽ
+} ParseState;
+
+// һ (ǡ IO_BLOCK ֽ)
+static void parse_block(const char* p, ParseState* st, IoVec* out) {
+    unsigned long long dig = digit_mask(p);
+
+    // Ƚǰһĩβû
+    if (st->pending) {
+        unsigned long long rest = ~dig;
+        int end = rest ? lowest_bit(rest) : IO_BLOCK;
+        for (int i = 0; i < end; i++) st->value = st->value * 10 + (unsigned)(p[i] - '0');
+        if (end == IO_BLOCK) {
+            st->prev = p[IO_BLOCK - 1];
+            return;
+        }
+        vec_push(out, st->negative ? 0 - st->value : st->value);
+        st->pending = 0;
+        dig &= ~0ULL << end;
+    }
+
+    while (dig) {
+        int start = lowest_bit(dig);
+        unsigned long long rest = ~(dig >> start);
+        int end = start + (rest ? lowest_bit(rest) : IO_BLOCK);
+        unsigned long long v = 0;
+        for (int i = start; i < end; i++) v = v * 10 + (unsigned)(p[i] - '0');
+        int negative = (start > 0 ? p[start - 1] : st->prev) == '-';
+        if (end >= IO_BLOCK) {
+            st->value = v;
+            st->negative = negative;
+            st->pending = 1;
+            break;
+        }
+        vec_push(out, negative ? 0 - v : v);
+        dig &= ~0ULL << end;
+    }
+    st->prev = p[IO_BLOCK - 1];
+}
+
+//  [begin, end)prev Ϊ begin ǰһֽ (ûΪ 0)end ܰж
+static void parse_range(const char* begin, const char* end, char prev, IoVec* out) {
+    ParseState st;
+    memset(&st, 0, sizeof(st));
+    st.prev = prev;
+
+    const char* p = begin;
+    for (; end - p >= IO_BLOCK; p += IO_BLOCK) parse_block(p, &st, out);
+
+    // һβո鴦˳ĩβ
+    char tail[IO_BLOCK];
+    size_t left = (size_t)(end - p);
+    memcpy(tail, p, left);
+    memset(tail + left, ' ', IO_BLOCK - left);
+    parse_block(tail, &st, out);
+}
+
+long long io_parse_text(const char* begin, const char* end, char prev, int* out, size_t capacity) {
+    IoVec v;
+    memset(&v, 0, sizeof(v));
+    v.data = out;
+    v.capacity = capacity;
+    v.fixed = 1;
+    parse_range(begin, end, prev, &v);
+    return v.failed ? -1 : (long long)v.count;
+}
+
+size_t io_text_cut(const char* base, size_t size, size_t pos) {
+    while (pos < size && (unsigned char)(base[pos] - '0') < 10) pos++;
+    return pos;
+}
+
+// 4. нֽھ֣зֵƵִ֮⣬ζ˳ƴ
+typedef struct {
+    const char* base;
+    const size_t* cuts;   // pieces + 1 зֵ
+    IoVec* parts;
+    int* dst;
+    const size_t* offsets;
+} ParseJob;
+
+static void parse_piece(void* arg, int index) {
+    ParseJob* job = (ParseJob*)arg;
+    size_t begin = job->cuts[index], end = job->cuts[index + 1];
+    IoVec* v = &job->parts[index];
+    v->capacity = (end - begin) / 8 + 1;   // ƽÿ 8 ֽԤ
+    v->data = (int*)malloc(v->capacity * sizeof(int));
+    if (!v->data) { v->failed = 1; return; }
+    parse_range(job->base + begin, job->base + end, begin ? job->base[begin - 1] : 0, v);
+}
+
+static void copy_piece(void* arg, int index) {
+    ParseJob* job = (ParseJob*)arg;
+    memcpy(job->dst + job->offsets[index], job->parts[index].data, job->parts[index].count * sizeof(int));
+}
+
+// 5. ӿ
+EXPORT int load_text_file(const char* path, int threads, int** arr, int* n) {
+    if (!path || !arr || !n) return -1;
+    *arr = NULL;
+    *n = 0;
+
+    IoMap m;
+    if (io_map(&m, path, 0) != 0) return -1;
+    if (m.size == 0) return 0;
+
+    if (threads <= 0) threads = pool_hardware_threads();
+    if (m.size < IO_PAR_MIN) threads = 1;
+    if (threads > POOL_MAX_THREADS) threads = POOL_MAX_THREADS;
+
+    size_t cuts[POOL_MAX_THREADS + 1];
+    size_t offsets[POOL_MAX_THREADS];
+    IoVec parts[POOL_MAX_THREADS];
+    memset(parts, 0, sizeof(IoVec) * (size_t)threads);
+    cuts[0] = 0;
+    for (int t = 1; t < threads; t++) {
+        size_t c = (size_t)((unsigned long long)m.size * (unsigned)t / (unsigned)threads);
+        cuts[t] = io_text_cut(m.base, m.size, c < cuts[t - 1] ? cuts[t - 1] : c);
+    }
+    cuts[threads] = m.size;
+
+    ParseJob job;
+    job.base = m.base;
+    job.cuts = cuts;
+    job.parts = parts;
+    job.offsets = offsets;
+    job.dst = NULL;
+    pool_parallel_for(threads, threads, parse_piece, &job);
+    io_unmap(m.base, m.size);
+
+    size_t total = 0;
+    int failed = 0;
+    for (int t = 0; t < threads; t++) {
+        offsets[t] = total;
+        total += parts[t].count;
+        failed |= parts[t].failed;
+    }
+    if (failed || total > 0x7fffffff) {
+        for (int t = 0; t < threads; t++) free(parts[t].data);
+        return -1;
+    }
+
+    if (threads == 1) {
+        // Σֱӽ壬ʵʴС
+        int* p = total ? (int*)realloc(parts[0].data, total * sizeof(int)) : NULL;
+        if (!p) free(parts[0].data);
+        *arr = p;
+    }
+    else if (total > 0) {
+        job.dst = (int*)malloc(total * sizeof(int));
+        if (job.dst) pool_parallel_for(threads, threads, copy_piece, &job);
+        for (int t = 0; t < threads; t++) free(parts[t].data);
+        if (!job.dst) return -1;
+        *arr = job.dst;
+    }
+    else {
+        for (int t = 0; t < threads; t++) free(parts[t].data);
+    }
+    *n = (int)total;
+    return 0;
+}
+
+EXPORT void sort_free(void* p) {
+    free(p);
+}
+
+#ifndef _WIN32
+// munmap Ҫӳʱĳȣload_binary_file Ǽǣunmap_binary_file ַȡء
+// ļͷ㣬дӳµ÷ѾĶͷ
+typedef struct BinMapping {
+    char* base;
+    size_t size;
+    struct BinMapping* next;
+} BinMapping;
+
+static BinMapping* g_binMaps = NULL;
+static pthread_mutex_t g_binMapLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+EXPORT int load_binary_file(const char* path, int writable, int** arr, int* n) {
+    if (!path || !arr || !n) return -1;
+    *arr = NULL;
+    *n = 0;
+
+    IoMap m;
+    if (io_map(&m, path, writable ? 2 : 1) != 0) return -1;
+    const SortBinHeader* h = (const SortBinHeader*)m.base;
+    if (m.size < sizeof(SortBinHeader) || h->magic != SORT_BIN_MAGIC || h->elemType != SORT_BIN_INT32
+        || h->count > 0x7fffffff || h->count > (m.size - sizeof(SortBinHeader)) / sizeof(int)) {
+        io_unmap(m.base, m.size);
+        return -1;
+    }
+#ifndef _WIN32
+    BinMapping* rec = (BinMapping*)malloc(sizeof(BinMapping));
+    if (!rec) {
+        io_unmap(m.base, m.size);
+        return -1;
+    }
+    rec->base = m.base;
+    rec->size = m.size;
+    pthread_mutex_lock(&g_binMapLock);
+    rec->next = g_binMaps;
+    g_binMaps = rec;
+    pthread_mutex_unlock(&g_binMapLock);
+#endif
+    *arr = (int*)(m.base + sizeof(SortBinHeader));
+    *n = (int)h->count;
+    return 0;
+}
+
+EXPORT int unmap_binary_file(int* arr) {
+    if (!arr) return -1;
+    char* base = (char*)arr - sizeof(SortBinHeader);
+#ifdef _WIN32
+    io_unmap(base, 0);
+    return 0;
+#else
+    BinMapping* rec = NULL;
+    pthread_mutex_lock(&g_binMapLock);
+    for (BinMapping** p = &g_binMaps; *p; p = &(*p)->next) {
+        if ((*p)->base == base) {
+            rec = *p;
+            *p = rec->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_binMapLock);
+    //  load_binary_file صָ
+    if (!rec) return -1;
+    io_unmap(rec->base, rec->size);
+    free(rec);
+    return 0;
+#endif
+}
+
+EXPORT int save_binary_file(const char* path, const int* arr, int n) {
+    if (!path || n < 0 || (!arr && n > 0)) return -1;
+    FILE* fp;
+#ifdef _WIN32
+    if (fopen_s(&fp, path, "wb") != 0) return -1;
+#else
+    fp = fopen(path, "wb");
+    if (!fp) return -1;
+#endif
+    SortBinHeader h;
+    h.magic = SORT_BIN_MAGIC;
+    h.elemType = SORT_BIN_INT32;
+    h.count = (unsigned long long)n;
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1 && fwrite(arr, sizeof(int), (size_t)n, fp) == (size_t)n;
+    return (fclose(fp) == 0 && ok) ? 0 : -1;
+}
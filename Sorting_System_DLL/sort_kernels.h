@@ -0,0 +1,213 @@
+// 㷨ںģ
+// ļû include guardsort_engine.c ڲͬ궨¶ΰ
+// ͬһԴɼ㿪ʵ֡ǰ趨壺
+//   SORT_FN(name)   Σ name  name##Fast
+//   COUNT_CMP()     һαȽ
+//   COUNT_MOVE(k)    k ƶ
+//   SORT_NETWORK(a, n)  С (n <= SIMD_NET_MAX) 磬Ϊ _ScalarNetwork㿪Ϊ SIMD
+//   TRACE_CMP(p, q) / TRACE_SWAP(p, q) / TRACE_WRITE(p) / TRACE_PHASE(p)
+//                   ׷٣ΪԪָ룬޸¼޸֮ãPHASE ʾλѹλ
+//                   ׷ٵİ汾Ϊ ((void)0)
+// 㿪мչΪգڲѭٶдȫּ
+// ɰȫģ֮ͳһ #undef
+
+static void SORT_FN(_Swap)(int* a, int* b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+    COUNT_MOVE(3);
+    TRACE_SWAP(a, b);
+}
+
+// 0. С ()
+//  sort_simd.c ͬ˫磬 INT_MAX  2 ݣȽ
+void SORT_FN(_ScalarNetwork)(int arr[], int n) {
+    if (n < 2) return;
+    int buf[SIMD_NET_MAX];
+    int size = 4;
+    while (size < n) size <<= 1;
+    memcpy(buf, arr, (size_t)n * sizeof(int)); COUNT_MOVE(n);
+    for (int i = n; i < size; i++) buf[i] = INT_MAX;
+    for (int s = 2; s <= size; s <<= 1) {
+        for (int d = s >> 1; d > 0; d >>= 1) {
+            for (int i = 0; i < size; i++) {
+                int j = d == s >> 1 ? i ^ (s - 1) : i ^ d;   // ÿһ뾵λñȽ
+                if (j < i) continue;
+                COUNT_CMP();
+                if (buf[j] < buf[i]) SORT_FN(_Swap)(&buf[i], &buf[j]);
+            }
+        }
+    }
+    memcpy(arr, buf, (size_t)n * sizeof(int)); COUNT_MOVE(n);
+    for (int i = 0; i < n; i++) TRACE_WRITE(&arr[i]);
+}
+
+// 1. ð
+void SORT_FN(_BubbleSort)(int arr[], int n) {
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - 1 - i; j++) {
+            COUNT_CMP(); TRACE_CMP(&arr[j], &arr[j + 1]);
+            if (arr[j] > arr[j + 1]) SORT_FN(_Swap)(&arr[j], &arr[j + 1]);
+        }
+        TRACE_PHASE(&arr[n - 1 - i]);
+    }
+    if (n > 0) TRACE_PHASE(&arr[0]);
+}
+
+// 2. 
+void SORT_FN(_InsertSort)(int arr[], int n) {
+    for (int i = 1; i < n; i++) {
+        int temp = arr[i]; COUNT_MOVE(1);
+        int j = i - 1;
+        while (j >= 0) {
+            COUNT_CMP(); TRACE_CMP(&arr[j], &arr[j + 1]);
+            if (arr[j] > temp) {
+                arr[j + 1] = arr[j]; COUNT_MOVE(1); TRACE_WRITE(&arr[j + 1]);
+                j--;
+            }
+            else break;
+        }
+        arr[j + 1] = temp; COUNT_MOVE(1); TRACE_WRITE(&arr[j + 1]);
+    }
+}
+
+// 3. ѡ
+void SORT_FN(_SelectSort)(int arr[], int n) {
+    for (int i = 0; i < n - 1; i++) {
+        int minIdx = i;
+        for (int j = i + 1; j < n; j++) {
+            COUNT_CMP(); TRACE_CMP(&arr[j], &arr[minIdx]);
+            if (arr[j] < arr[minIdx]) minIdx = j;
+        }
+        if (minIdx != i) SORT_FN(_Swap)(&arr[i], &arr[minIdx]);
+        TRACE_PHASE(&arr[i]);
+    }
+    if (n > 0) TRACE_PHASE(&arr[n - 1]);
+}
+
+// 4. ϣ
+void SORT_FN(_ShellSort)(int arr[], int n) {
+    for (int gap = n / 2; gap > 0; gap /= 2) {
+        for (int i = gap; i < n; i++) {
+            int temp = arr[i]; COUNT_MOVE(1);
+            int j = i;
+            while (j >= gap) {
+                COUNT_CMP(); TRACE_CMP(&arr[j - gap], &arr[j]);
+                if (arr[j - gap] > temp) {
+                    arr[j] = arr[j - gap]; COUNT_MOVE(1); TRACE_WRITE(&arr[j]);
+                    j -= gap;
+                }
+                else break;
+            }
+            arr[j] = temp; COUNT_MOVE(1); TRACE_WRITE(&arr[j]);
+        }
+    }
+}
+
+// 5. 
+void SORT_FN(_HeapAdjustIterative)(int arr[], int n, int i) {
+    int temp = arr[i]; COUNT_MOVE(1);
+    int k = 2 * i + 1;
+    while (k < n) {
+        if (k + 1 < n) {
+            COUNT_CMP(); TRACE_CMP(&arr[k], &arr[k + 1]);
+            if (arr[k] < arr[k + 1]) k++;
+        }
+        COUNT_CMP(); TRACE_CMP(&arr[k], &arr[i]);
+        if (arr[k] > temp) {
+            arr[i] = arr[k]; COUNT_MOVE(1); TRACE_WRITE(&arr[i]);
+            i = k;
+            k = 2 * i + 1;
+        }
+        else break;
+    }
+    arr[i] = temp; COUNT_MOVE(1); TRACE_WRITE(&arr[i]);
+}
+void SORT_FN(_HeapSort)(int arr[], int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) SORT_FN(_HeapAdjustIterative)(arr, n, i);
+    for (int i = n - 1; i > 0; i--) {
+        SORT_FN(_Swap)(&arr[0], &arr[i]);
+        TRACE_PHASE(&arr[i]);
+        SORT_FN(_HeapAdjustIterative)(arr, i, 0);
+    }
+    if (n > 0) TRACE_PHASE(&arr[0]);
+}
+
+// 6. 鲢
+void SORT_FN(_Merge)(int arr[], int l, int m, int r, int temp[]) {
+    int i = l, j = m + 1, k = l;
+    while (i <= m && j <= r) {
+        COUNT_CMP(); TRACE_CMP(&arr[i], &arr[j]);
+        if (arr[i] <= arr[j]) { temp[k++] = arr[i++]; COUNT_MOVE(1); }
+        else { temp[k++] = arr[j++]; COUNT_MOVE(1); }
+    }
+    while (i <= m) { temp[k++] = arr[i++]; COUNT_MOVE(1); }
+    while (j <= r) { temp[k++] = arr[j++]; COUNT_MOVE(1); }
+    for (i = l; i <= r; i++) { arr[i] = temp[i]; COUNT_MOVE(1); TRACE_WRITE(&arr[i]); }
+}
+void SORT_FN(_MergeSortIterative)(int arr[], int n) {
+    int* temp = scratch_acquire(n);
+    if (!temp) return;
+
+    // ײֱɳ NET_RUN 
+    for (int i = 0; i < n; i += NET_RUN) SORT_NETWORK(arr + i, min_val(NET_RUN, n - i));
+
+    for (int curr_size = NET_RUN; curr_size <= n - 1; curr_size = 2 * curr_size) {
+        for (int left_start = 0; left_start < n - 1; left_start += 2 * curr_size) {
+            int mid = min_val(left_start + curr_size - 1, n - 1);
+            int right_end = min_val(left_start + 2 * curr_size - 1, n - 1);
+            SORT_FN(_Merge)(arr, left_start, mid, right_end, temp);
+        }
+    }
+    scratch_release(temp);
+}
+
+// 7. 
+int SORT_FN(_Partition)(int arr[], int low, int high) {
+    int pivot = arr[high]; COUNT_MOVE(1);
+    int i = low - 1;
+    for (int j = low; j < high; j++) {
+        COUNT_CMP(); TRACE_CMP(&arr[j], &arr[high]);
+        if (arr[j] < pivot) {
+            i++;
+            SORT_FN(_Swap)(&arr[i], &arr[j]);
+        }
+    }
+    SORT_FN(_Swap)(&arr[i + 1], &arr[high]);
+    TRACE_PHASE(&arr[i + 1]);
+    return i + 1;
+}
+void SORT_FN(_QuickSortIterative)(int arr[], int n) {
+    if (n <= 0) return;
+
+    // ϴһջСһŻ֣ÿջһ㵱ǰټ룬̶Сջ㹻
+    StackNode stack[QS_STACK_DEPTH];
+    int top = 0;
+    int low = 0, high = n - 1;
+    for (;;) {
+        if (high - low < NET_RUN) {
+            if (low < high) SORT_NETWORK(arr + low, high - low + 1);
+            // Ҷźúιλ
+            for (int k = low; k <= high; k++) TRACE_PHASE(&arr[k]);
+            if (top == 0) break;
+            top--;
+            low = stack[top].low;
+            high = stack[top].high;
+            continue;
+        }
+
+        int pivot = SORT_FN(_Partition)(arr, low, high);
+
+        if (pivot - low > high - pivot) {
+            stack[top].low = low;
+            stack[top].high = pivot - 1;
+            low = pivot + 1;
+        }
+        else {
+            stack[top].low = pivot + 1;
+            stack[top].high = high;
+            high = pivot - 1;
+        }
+        top++;
+    }
+}
@@ -0,0 +1,297 @@
+// 㷨ںģ (ʽ sort_kernels.h ͬ)
+// ̵߳ sort_thread.c ̳߳ظֻдÿʲô
+
+// 8. й鲢 (Ե)
+// ÿһ˵ [0, n) ֳ pieces ݣǰһݸСΣ
+// һδ鲢гɶݣ co-rank ֶλе㣬
+// ÿһ̶߳лɡʱȡԪأȶ
+
+// co-rankȶ鲢 a[0..la)  b[0..lb) ʱǰ k Ԫ a ĸ
+static int SORT_FN(_CoRank)(int k, const int* a, int la, const int* b, int lb) {
+    int lo = k > lb ? k - lb : 0;
+    int hi = k < la ? k : la;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        int j = k - i;
+        COUNT_CMP();
+        if (j > 0 && a[i] <= b[j - 1]) lo = i + 1;   // a[i] Ӧ b[j-1] ֮ǰi ȡ
+        else hi = i;
+    }
+    return lo;
+}
+
+static void SORT_FN(_MergeTo)(const int* a, int la, const int* b, int lb, int* out) {
+    int i = 0, j = 0, k = 0;
+    while (i < la && j < lb) {
+        COUNT_CMP();
+        if (a[i] <= b[j]) out[k++] = a[i++];
+        else out[k++] = b[j++];
+        COUNT_MOVE(1);
+    }
+    while (i < la) { out[k++] = a[i++]; COUNT_MOVE(1); }
+    while (j < lb) { out[k++] = b[j++]; COUNT_MOVE(1); }
+}
+
+// 񣺶Ե piece ڵÿʼ ( width) ź
+static void SORT_FN(_RunTask)(void* arg, int piece) {
+    MergePass* pass = (MergePass*)arg;
+    int* arr = pass->dst;
+    int runs = (pass->n + pass->width - 1) / pass->width;
+    int first = (int)((long long)runs * piece / pass->pieces);
+    int last = (int)((long long)runs * (piece + 1) / pass->pieces);
+    for (int r = first; r < last; r++) {
+        int start = r * pass->width;
+        SORT_NETWORK(arr + start, min_val(pass->width, pass->n - start));
+    }
+}
+
+// ɱ [o0, o1) Ĺ鲢
+static void SORT_FN(_MergePieceTask)(void* arg, int piece) {
+    MergePass* pass = (MergePass*)arg;
+    int n = pass->n, w = pass->width;
+    int o0 = (int)((long long)n * piece / pass->pieces);
+    int o1 = (int)((long long)n * (piece + 1) / pass->pieces);
+
+    for (int l = o0 / (2 * w) * (2 * w); l < o1; l += 2 * w) {
+        int m = min_val(l + w, n);
+        int r = min_val(l + 2 * w, n);
+        const int* a = pass->src + l;
+        const int* b = pass->src + m;
+        int la = m - l, lb = r - m;
+
+        //  [o0, o1) ڵĲ ( l)
+        int k0 = (o0 > l ? o0 : l) - l;
+        int k1 = (o1 < r ? o1 : r) - l;
+        int i0 = k0 == 0 ? 0 : SORT_FN(_CoRank)(k0, a, la, b, lb);
+        int i1 = k1 == la + lb ? la : SORT_FN(_CoRank)(k1, a, la, b, lb);
+        SORT_FN(_MergeTo)(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), pass->dst + l + k0);
+    }
+}
+
+// 񣺰 src ĵ piece ݿ dst
+static void SORT_FN(_CopyTask)(void* arg, int piece) {
+    MergePass* pass = (MergePass*)arg;
+    int o0 = (int)((long long)pass->n * piece / pass->pieces);
+    int o1 = (int)((long long)pass->n * (piece + 1) / pass->pieces);
+    memcpy(pass->dst + o0, pass->src + o0, (size_t)(o1 - o0) * sizeof(int));
+    COUNT_MOVE(o1 - o0);
+}
+
+void SORT_FN(_ParallelMergeSort)(int arr[], int n) {
+    if (n <= 1) return;
+    int threads = ctx_threads();
+    if (n < PAR_MIN_SIZE) threads = 1;
+
+    int* temp = scratch_acquire(n);
+    if (!temp) {
+        // ڴ治ʱ˻Ϊԭض
+        SORT_FN(_HeapSort)(arr, n);
+        return;
+    }
+
+    // ÿ̷ּ߳ݣ̻߳
+    MergePass pass;
+    pass.n = n;
+    pass.pieces = threads == 1 ? 1 : threads * 4;
+
+    // 1) ʼΣ PAR_RUN Ŀ (SORT_NETWORK) ź
+    pass.src = arr;
+    pass.dst = arr;
+    pass.width = PAR_RUN;
+    pool_parallel_for(pass.pieces, threads, SORT_FN(_RunTask), &pass);
+
+    // 2) ˹鲢src/dst ʹã˿
+    const int* src = arr;
+    int* dst = temp;
+    for (int width = PAR_RUN; width < n; width *= 2) {
+        pass.src = src;
+        pass.dst = dst;
+        pass.width = width;
+        pool_parallel_for(pass.pieces, threads, SORT_FN(_MergePieceTask), &pass);
+        src = dst;
+        dst = (dst == temp) ? arr : temp;
+    }
+
+    // 3)  temp ʱԭ
+    if (src != arr) {
+        pass.src = src;
+        pass.dst = arr;
+        pool_parallel_for(pass.pieces, threads, SORT_FN(_CopyTask), &pass);
+    }
+    scratch_release(temp);
+}
+
+// 9. п (ȡ)
+// 㻮̲߳ɣ֮ÿ̴߳Լ䣬
+// ֺѽϴһŻضйȡԼСһ룬
+// С PAR_QS_CUTOFF ʱ͵˳
+
+// ȡк Hoare ֣ j[low, j] <= pivot <= [j+1, high]
+static int SORT_FN(_HoarePartition)(int arr[], int low, int high) {
+    int mid = low + (high - low) / 2;
+    COUNT_CMP();
+    if (arr[mid] < arr[low]) SORT_FN(_Swap)(&arr[mid], &arr[low]);
+    COUNT_CMP();
+    if (arr[high] < arr[low]) SORT_FN(_Swap)(&arr[high], &arr[low]);
+    COUNT_CMP();
+    if (arr[high] < arr[mid]) SORT_FN(_Swap)(&arr[high], &arr[mid]);
+    SORT_FN(_Swap)(&arr[low], &arr[mid]);   // λŵ low Ϊ׼
+
+    int pivot = arr[low]; COUNT_MOVE(1);
+    int i = low - 1, j = high + 1;
+    for (;;) {
+        do { i++; COUNT_CMP(); } while (arr[i] < pivot);
+        do { j--; COUNT_CMP(); } while (arr[j] > pivot);
+        if (i >= j) return j;
+        SORT_FN(_Swap)(&arr[i], &arr[j]);
+    }
+}
+
+// ˳ [low, high]ϴһջСһջ log2(n)
+static void SORT_FN(_SeqQuickRange)(int arr[], int low, int high) {
+    WsRange stack[64];
+    int top = 0;
+    for (;;) {
+        while (high - low + 1 > PAR_QS_INSERT) {
+            int j = SORT_FN(_HoarePartition)(arr, low, high);
+            if (j - low > high - j - 1) {
+                stack[top].low = low; stack[top].high = j; top++;
+                low = j + 1;
+            }
+            else {
+                stack[top].low = j + 1; stack[top].high = high; top++;
+                high = j;
+            }
+        }
+        if (high > low) SORT_NETWORK(arr + low, high - low + 1);
+        if (top == 0) break;
+        top--;
+        low = stack[top].low;
+        high = stack[top].high;
+    }
+}
+
+// ȡصһ
+static void SORT_FN(_ParallelQuickRange)(void* arg, WsWorker* self, int low, int high) {
+    int* arr = (int*)arg;
+    while (high - low + 1 > PAR_QS_CUTOFF) {
+        int j = SORT_FN(_HoarePartition)(arr, low, high);
+        if (j - low > high - j - 1) {
+            ws_push(self, low, j);
+            low = j + 1;
+        }
+        else {
+            ws_push(self, j + 1, high);
+            high = j;
+        }
+    }
+    SORT_FN(_SeqQuickRange)(arr, low, high);
+}
+
+// ͳƵ piece  С// pivot ĸ
+static void SORT_FN(_PartitionCountTask)(void* arg, int piece) {
+    PartitionPass* pp = (PartitionPass*)arg;
+    int o0 = (int)((long long)pp->n * piece / pp->pieces);
+    int o1 = (int)((long long)pp->n * (piece + 1) / pp->pieces);
+    int less = 0, greater = 0;
+    for (int i = o0; i < o1; i++) {
+        COUNT_CMP();
+        if (pp->src[i] < pp->pivot) less++;
+        else {
+            COUNT_CMP();
+            if (pp->src[i] > pp->pivot) greater++;
+        }
+    }
+    pp->counts[3 * piece] = less;
+    pp->counts[3 * piece + 1] = (o1 - o0) - less - greater;
+    pp->counts[3 * piece + 2] = greater;
+}
+
+// 񣺰ѵ piece ݰηֱдԵ
+static void SORT_FN(_PartitionScatterTask)(void* arg, int piece) {
+    PartitionPass* pp = (PartitionPass*)arg;
+    int o0 = (int)((long long)pp->n * piece / pp->pieces);
+    int o1 = (int)((long long)pp->n * (piece + 1) / pp->pieces);
+    int lt = pp->counts[3 * piece];
+    int eq = pp->counts[3 * piece + 1];
+    int gt = pp->counts[3 * piece + 2];
+    for (int i = o0; i < o1; i++) {
+        int v = pp->src[i];
+        if (v < pp->pivot) pp->dst[lt++] = v;
+        else if (v > pp->pivot) pp->dst[gt++] = v;
+        else pp->dst[eq++] = v;
+        COUNT_MOVE(1);
+    }
+}
+
+// ·֣ [0, *lessEnd) < pivot[*greaterStart, n) > pivotм pivot
+static int SORT_FN(_ParallelPartition)(int arr[], int n, int threads, int* lessEnd, int* greaterStart) {
+    int* temp = scratch_acquire(n);
+    PartitionPass pp;
+    pp.pieces = threads * 4;
+    pp.counts = (int*)scratch_alloc((size_t)pp.pieces * 3 * sizeof(int));
+    if (!temp || !pp.counts) {
+        if (temp) scratch_release(temp);
+        scratch_free(pp.counts);
+        return 0;
+    }
+
+    // סСβȡΪ׼
+    int a = arr[0], b = arr[n / 2], c = arr[n - 1];
+    COUNT_CMP(); COUNT_CMP();
+    pp.pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a)) : ((a < c) ? a : (b < c ? c : b));
+    pp.src = arr;
+    pp.dst = temp;
+    pp.n = n;
+    pool_parallel_for(pp.pieces, threads, SORT_FN(_PartitionCountTask), &pp);
+
+    // ǰ׺ͣεд
+    int less = 0, equal = 0;
+    for (int p = 0; p < pp.pieces; p++) {
+        less += pp.counts[3 * p];
+        equal += pp.counts[3 * p + 1];
+    }
+    int offLt = 0, offEq = less, offGt = less + equal;
+    for (int p = 0; p < pp.pieces; p++) {
+        int lt = pp.counts[3 * p], eq = pp.counts[3 * p + 1], gt = pp.counts[3 * p + 2];
+        pp.counts[3 * p] = offLt;
+        pp.counts[3 * p + 1] = offEq;
+        pp.counts[3 * p + 2] = offGt;
+        offLt += lt; offEq += eq; offGt += gt;
+    }
+    pool_parallel_for(pp.pieces, threads, SORT_FN(_PartitionScatterTask), &pp);
+
+    MergePass copy;
+    copy.src = temp;
+    copy.dst = arr;
+    copy.n = n;
+    copy.pieces = pp.pieces;
+    pool_parallel_for(copy.pieces, threads, SORT_FN(_CopyTask), &copy);
+
+    *lessEnd = less;
+    *greaterStart = less + equal;
+    scratch_free(pp.counts);
+    scratch_release(temp);
+    return 1;
+}
+
+void SORT_FN(_ParallelQuickSort)(int arr[], int n) {
+    if (n <= 1) return;
+    int threads = ctx_threads();
+    if (n < PAR_MIN_SIZE || threads == 1) {
+        SORT_FN(_SeqQuickRange)(arr, 0, n - 1);
+        return;
+    }
+
+    WsRange roots[2];
+    int rootCount = 0;
+    int lessEnd, greaterStart;
+    if (SORT_FN(_ParallelPartition)(arr, n, threads, &lessEnd, &greaterStart)) {
+        if (lessEnd > 1) { roots[rootCount].low = 0; roots[rootCount].high = lessEnd - 1; rootCount++; }
+        if (n - greaterStart > 1) { roots[rootCount].low = greaterStart; roots[rootCount].high = n - 1; rootCount++; }
+    }
+    else {
+        roots[0].low = 0; roots[0].high = n - 1; rootCount = 1;   // ڴ治ʱл
+    }
+    pool_work_stealing(threads, roots, rootCount, SORT_FN(_ParallelQuickRange), arr);
+}
@@ -0,0 +1,322 @@
+// ģʽںģ (ʽ sort_kernels.h ͬ)
+// ԪҲģǰ趨壺
+//   SORT_T               Ԫ
+//   SORT_LESS(a, b)      a Ƿϸ b (ϸ)ֵܱ
+// ѡ
+//   SORT_HEAPSORT(a, n)  ʧʱĺ󱸶int ʵ sort_kernels.h  _HeapSort
+//                        δʱʹñļͨð汾
+
+// 11. ģʽ (pdqsort)
+// ͨӣ
+//   - ȡУϴʱþȡ (ninther) ѡ׼
+//   - 黮֣Ȱ¼轻Ԫصƫƣٳڲѭûз֧
+//   - ʱûз඼""ʱֱӽԵ
+//   - ׼Ԫʱѵڻ׼ԪһԹ鵽ߣظֵҲ˻
+//   - ʧʱҲԪأʧ log2(n) ö O(n log n)
+// ֻݹСһ࣬ϴһѭмݹȲ log2(n)
+
+static void SORT_FN(_PdqSwap)(SORT_T* a, SORT_T* b) {
+    SORT_T t = *a;
+    *a = *b;
+    *b = t;
+    COUNT_MOVE(3);
+}
+
+// ʧʱĺ󱸣
+#ifndef SORT_HEAPSORT
+static void SORT_FN(_PdqSiftDown)(SORT_T* a, int n, int i) {
+    SORT_T t = a[i]; COUNT_MOVE(1);
+    int k = 2 * i + 1;
+    while (k < n) {
+        if (k + 1 < n) {
+            COUNT_CMP();
+            if (SORT_LESS(a[k], a[k + 1])) k++;
+        }
+        COUNT_CMP();
+        if (!SORT_LESS(t, a[k])) break;
+        a[i] = a[k]; COUNT_MOVE(1);
+        i = k;
+        k = 2 * i + 1;
+    }
+    a[i] = t; COUNT_MOVE(1);
+}
+
+static void SORT_FN(_PdqHeapSort)(SORT_T* a, int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) SORT_FN(_PdqSiftDown)(a, n, i);
+    for (int i = n - 1; i > 0; i--) {
+        SORT_FN(_PdqSwap)(&a[0], &a[i]);
+        SORT_FN(_PdqSiftDown)(a, i, 0);
+    }
+}
+#define PDQ_HEAPSORT(a, n) SORT_FN(_PdqHeapSort)(a, n)
+#else
+#define PDQ_HEAPSORT(a, n) SORT_HEAPSORT(a, n)
+#endif
+
+static void SORT_FN(_PdqSort2)(SORT_T* a, SORT_T* b) {
+    COUNT_CMP();
+    if (SORT_LESS(*b, *a)) SORT_FN(_PdqSwap)(a, b);
+}
+
+static void SORT_FN(_PdqSort3)(SORT_T* a, SORT_T* b, SORT_T* c) {
+    SORT_FN(_PdqSort2)(a, b);
+    SORT_FN(_PdqSort2)(b, c);
+    SORT_FN(_PdqSort2)(a, b);
+}
+
+//  [begin, end)guarded Ϊ 0 ʱҪ begin[-1] κԪأʡȥ߽
+static void SORT_FN(_PdqInsertion)(SORT_T* begin, SORT_T* end, int guarded) {
+    if (begin == end) return;
+    for (SORT_T* cur = begin + 1; cur < end; cur++) {
+        SORT_T* sift = cur;
+        SORT_T* sift1 = cur - 1;
+        COUNT_CMP();
+        if (SORT_LESS(*sift, *sift1)) {
+            SORT_T tmp = *sift; COUNT_MOVE(1);
+            do {
+                *sift-- = *sift1; COUNT_MOVE(1);
+            } while ((!guarded || sift != begin) && (COUNT_CMP(), (--sift1, SORT_LESS(tmp, *sift1))));
+            *sift = tmp; COUNT_MOVE(1);
+        }
+    }
+}
+
+// Բۼƶ PDQ_PARTIAL_LIMIT ͷǷź
+static int SORT_FN(_PdqPartialInsertion)(SORT_T* begin, SORT_T* end) {
+    if (begin == end) return 1;
+    int limit = 0;
+    for (SORT_T* cur = begin + 1; cur < end; cur++) {
+        SORT_T* sift = cur;
+        SORT_T* sift1 = cur - 1;
+        COUNT_CMP();
+        if (SORT_LESS(*sift, *sift1)) {
+            SORT_T tmp = *sift; COUNT_MOVE(1);
+            do {
+                *sift-- = *sift1; COUNT_MOVE(1);
+            } while (sift != begin && (COUNT_CMP(), (--sift1, SORT_LESS(tmp, *sift1))));
+            *sift = tmp; COUNT_MOVE(1);
+            limit += (int)(cur - sift);
+        }
+        if (limit > PDQ_PARTIAL_LIMIT) return 0;
+    }
+    return 1;
+}
+
+// ƫƳĴλԪأʱѭλÿԪֻһ
+static void SORT_FN(_PdqSwapOffsets)(SORT_T* first, SORT_T* last, const unsigned char* offL,
+    const unsigned char* offR, int num, int useSwaps) {
+    if (useSwaps) {
+        for (int i = 0; i < num; i++) SORT_FN(_PdqSwap)(first + offL[i], last - offR[i]);
+    }
+    else if (num > 0) {
+        SORT_T* l = first + offL[0];
+        SORT_T* r = last - offR[0];
+        SORT_T tmp = *l;
+        *l = *r;
+        for (int i = 1; i < num; i++) {
+            l = first + offL[i];
+            *r = *l;
+            r = last - offR[i];
+            *l = *r;
+        }
+        *r = tmp;
+        COUNT_MOVE(2 * num + 1);
+    }
+}
+
+//  *begin Ϊ׼ [begin, end)Сڻ׼ҡ
+// ػ׼λã*already ʾǰѾǻֺõ (ûз)
+static SORT_T* SORT_FN(_PdqPartitionRight)(SORT_T* begin, SORT_T* end, int* already) {
+    SORT_T pivot = *begin; COUNT_MOVE(1);
+    SORT_T* first = begin;
+    SORT_T* last = end;
+
+    // ҵһԴλԪأbegin ֮һԪؾͲСڻ׼ʱҲɨҪ߽
+    while (COUNT_CMP(), (++first, SORT_LESS(*first, pivot)));
+    if (first - 1 == begin) {
+        while (first < last && (COUNT_CMP(), !(--last, SORT_LESS(*last, pivot))));
+    }
+    else {
+        while (COUNT_CMP(), !(--last, SORT_LESS(*last, pivot)));
+    }
+
+    *already = first >= last;
+    if (!*already) {
+        SORT_FN(_PdqSwap)(first, last);
+        first++;
+
+        unsigned char offL[PDQ_BLOCK];
+        unsigned char offR[PDQ_BLOCK];
+        SORT_T* baseL = first;
+        SORT_T* baseR = last;
+        int numL = 0, numR = 0, startL = 0, startR = 0;
+
+        while (first < last) {
+            int unknown = (int)(last - first);
+            int splitL = numL == 0 ? (numR == 0 ? unknown / 2 : unknown) : 0;
+            int splitR = numR == 0 ? unknown - splitL : 0;
+            if (splitL > PDQ_BLOCK) splitL = PDQ_BLOCK;
+            if (splitR > PDQ_BLOCK) splitR = PDQ_BLOCK;
+
+            // ޷֧ؼ¼಻Сڻ׼ҲСڻ׼Ԫƫ
+            for (int i = 0; i < splitL; i++) {
+                offL[numL] = (unsigned char)i;
+                numL += !SORT_LESS(*first, pivot); COUNT_CMP();
+                first++;
+            }
+            for (int i = 0; i < splitR;) {
+                offR[numR] = (unsigned char)++i;
+                numR += (--last, SORT_LESS(*last, pivot)); COUNT_CMP();
+            }
+
+            int num = numL < numR ? numL : numR;
+            SORT_FN(_PdqSwapOffsets)(baseL, baseR, offL + startL, offR + startR, num, numL == numR);
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+            if (numL == 0) { startL = 0; baseL = first; }
+            if (numR == 0) { startR = 0; baseR = last; }
+        }
+
+        // ʣһ໹δԪأм
+        if (numL) {
+            const unsigned char* o = offL + startL;
+            while (numL--) SORT_FN(_PdqSwap)(baseL + o[numL], --last);
+            first = last;
+        }
+        if (numR) {
+            const unsigned char* o = offR + startR;
+            while (numR--) SORT_FN(_PdqSwap)(baseR - o[numR], first), first++;
+        }
+    }
+
+    SORT_T* pivotPos = first - 1;
+    *begin = *pivotPos;
+    *pivotPos = pivot;
+    COUNT_MOVE(2);
+    return pivotPos;
+}
+
+//  *begin Ϊ׼֣ڻ׼ڻ׼ begin[-1] ȵ
+// ʱȫڻ׼
+static SORT_T* SORT_FN(_PdqPartitionLeft)(SORT_T* begin, SORT_T* end) {
+    SORT_T pivot = *begin; COUNT_MOVE(1);
+    SORT_T* first = begin;
+    SORT_T* last = end;
+
+    while (COUNT_CMP(), (--last, SORT_LESS(pivot, *last)));
+    if (last + 1 == end) {
+        while (first < last && (COUNT_CMP(), !(++first, SORT_LESS(pivot, *first))));
+    }
+    else {
+        while (COUNT_CMP(), !(++first, SORT_LESS(pivot, *first)));
+    }
+
+    while (first < last) {
+        SORT_FN(_PdqSwap)(first, last);
+        while (COUNT_CMP(), (--last, SORT_LESS(pivot, *last)));
+        while (COUNT_CMP(), !(++first, SORT_LESS(pivot, *first)));
+    }
+
+    *begin = *last;
+    *last = pivot;
+    COUNT_MOVE(2);
+    return last;
+}
+
+// ʧһļλãƻʧģʽ
+static void SORT_FN(_PdqBreakPatterns)(SORT_T* begin, SORT_T* pivotPos, SORT_T* end) {
+    int lSize = (int)(pivotPos - begin);
+    int rSize = (int)(end - (pivotPos + 1));
+    if (lSize >= PDQ_INSERTION) {
+        SORT_FN(_PdqSwap)(begin, begin + lSize / 4);
+        SORT_FN(_PdqSwap)(pivotPos - 1, pivotPos - lSize / 4);
+        if (lSize > PDQ_NINTHER) {
+            SORT_FN(_PdqSwap)(begin + 1, begin + (lSize / 4 + 1));
+            SORT_FN(_PdqSwap)(begin + 2, begin + (lSize / 4 + 2));
+            SORT_FN(_PdqSwap)(pivotPos - 2, pivotPos - (lSize / 4 + 1));
+            SORT_FN(_PdqSwap)(pivotPos - 3, pivotPos - (lSize / 4 + 2));
+        }
+    }
+    if (rSize >= PDQ_INSERTION) {
+        SORT_FN(_PdqSwap)(pivotPos + 1, pivotPos + (1 + rSize / 4));
+        SORT_FN(_PdqSwap)(end - 1, end - rSize / 4);
+        if (rSize > PDQ_NINTHER) {
+            SORT_FN(_PdqSwap)(pivotPos + 2, pivotPos + (2 + rSize / 4));
+            SORT_FN(_PdqSwap)(pivotPos + 3, pivotPos + (3 + rSize / 4));
+            SORT_FN(_PdqSwap)(end - 2, end - (1 + rSize / 4));
+            SORT_FN(_PdqSwap)(end - 3, end - (2 + rSize / 4));
+        }
+    }
+}
+
+// leftmost Ϊ 0 ʱ begin[-1] ҲκԪ
+static void SORT_FN(_PdqLoop)(SORT_T* begin, SORT_T* end, int badAllowed, int leftmost) {
+    for (;;) {
+        int size = (int)(end - begin);
+        if (size < PDQ_INSERTION) {
+            SORT_FN(_PdqInsertion)(begin, end, leftmost);
+            return;
+        }
+
+        // ׼ѡȡ *begin
+        int s2 = size / 2;
+        if (size > PDQ_NINTHER) {
+            SORT_FN(_PdqSort3)(begin, begin + s2, end - 1);
+            SORT_FN(_PdqSort3)(begin + 1, begin + (s2 - 1), end - 2);
+            SORT_FN(_PdqSort3)(begin + 2, begin + (s2 + 1), end - 3);
+            SORT_FN(_PdqSort3)(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            SORT_FN(_PdqSwap)(begin, begin + s2);
+        }
+        else {
+            SORT_FN(_PdqSort3)(begin + s2, begin, end - 1);
+        }
+
+        // ׼Ԫأڻ׼ֵ鵽ߣֻұ
+        if (!leftmost) {
+            COUNT_CMP();
+            if (!SORT_LESS(begin[-1], *begin)) {
+                begin = SORT_FN(_PdqPartitionLeft)(begin, end) + 1;
+                continue;
+            }
+        }
+
+        int already;
+        SORT_T* pivotPos = SORT_FN(_PdqPartitionRight)(begin, end, &already);
+        int lSize = (int)(pivotPos - begin);
+        int rSize = (int)(end - (pivotPos + 1));
+
+        if (lSize < size / 8 || rSize < size / 8) {
+            if (--badAllowed == 0) {
+                PDQ_HEAPSORT(begin, size);
+                return;
+            }
+            SORT_FN(_PdqBreakPatterns)(begin, pivotPos, end);
+        }
+        else if (already && SORT_FN(_PdqPartialInsertion)(begin, pivotPos)
+            && SORT_FN(_PdqPartialInsertion)(pivotPos + 1, end)) {
+            return;
+        }
+
+        // ݹСһ࣬ϴһڱѭ
+        if (lSize < rSize) {
+            SORT_FN(_PdqLoop)(begin, pivotPos, badAllowed, leftmost);
+            begin = pivotPos + 1;
+            leftmost = 0;
+        }
+        else {
+            SORT_FN(_PdqLoop)(pivotPos + 1, end, badAllowed, 0);
+            end = pivotPos;
+        }
+    }
+}
+
+void SORT_FN(_PdqSort)(SORT_T arr[], int n) {
+    if (n <= 1) return;
+    int log2n = 0;
+    while ((n >> log2n) > 1) log2n++;
+    SORT_FN(_PdqLoop)(arr, arr + n, log2n, 1);
+}
+
+#undef PDQ_HEAPSORT
@@ -0,0 +1,139 @@
+// ƹҹ鲢ںģ (ʽ sort_kernels.h ͬ)
+
+// 13. ƹҹ鲢
+//  _MergeSortIterative ͬΪԵϵȶ鲢ڣ
+//   - ÿ˴ src 鲢 dst ߻οԭ飬ÿÿԪֻƶһ
+//   - ڲѭûصķ֧ȽϽֱָ벽ϲԼһԤʧ
+//   - ʣ೤ȵСֵôಽڲжȡգѭڲؼ߽
+//   - ·ÿ˹鲢ĸΣ룻ĳȡպΪ··
+// ʼ (int ȼ֣籾ȶҲ޴Ӳ)μʱȡǰĶΣ鲢ȶ
+
+//  k (<= 4)  src βӵι鲢 out
+static void SORT_FN(_PingPongMerge)(const int* p[4], const int* e[4], int k, int* out) {
+    // βѾν (򡢽ĳ) ʱ忽
+    int ordered = 1;
+    for (int r = 1; r < k && ordered; r++) {
+        COUNT_CMP();
+        ordered = !(p[r][0] < e[r - 1][-1]);
+    }
+    if (ordered) {
+        memcpy(out, p[0], (size_t)(e[k - 1] - p[0]) * sizeof(int));
+        COUNT_MOVE(e[k - 1] - p[0]);
+        return;
+    }
+
+    for (;;) {
+        // ȥȡյĶΣȺ˳
+        int live = 0;
+        for (int r = 0; r < k; r++) {
+            if (p[r] < e[r]) {
+                p[live] = p[r];
+                e[live] = e[r];
+                live++;
+            }
+        }
+        k = live;
+        if (k <= 1) break;
+
+        ptrdiff_t safe = e[0] - p[0];
+        for (int r = 1; r < k; r++) {
+            if (e[r] - p[r] < safe) safe = e[r] - p[r];
+        }
+
+        const int* a = p[0];
+        const int* b = p[1];
+        if (k == 2) {
+            for (ptrdiff_t s = 0; s < safe; s++) {
+                int x0 = *a, x1 = *b;
+                int t = x1 < x0;
+                COUNT_CMP();
+                *out++ = t ? x1 : x0; COUNT_MOVE(1);
+                a += !t;
+                b += t;
+            }
+        }
+        else if (k == 3) {
+            const int* c = p[2];
+            for (ptrdiff_t s = 0; s < safe; s++) {
+                int x0 = *a, x1 = *b, x2 = *c;
+                int t01 = x1 < x0;
+                int v01 = t01 ? x1 : x0;
+                int right = x2 < v01;
+                COUNT_CMP(); COUNT_CMP();
+                *out++ = right ? x2 : v01; COUNT_MOVE(1);
+                a += (!right) & (!t01);
+                b += (!right) & t01;
+                c += right;
+            }
+            p[2] = c;
+        }
+        else {
+            const int* c = p[2];
+            const int* d = p[3];
+            for (ptrdiff_t s = 0; s < safe; s++) {
+                int x0 = *a, x1 = *b, x2 = *c, x3 = *d;
+                int t01 = x1 < x0, t23 = x3 < x2;
+                int v01 = t01 ? x1 : x0, v23 = t23 ? x3 : x2;
+                int right = v23 < v01;
+                COUNT_CMP(); COUNT_CMP(); COUNT_CMP();
+                *out++ = right ? v23 : v01; COUNT_MOVE(1);
+                a += (!right) & (!t01);
+                b += (!right) & t01;
+                c += right & (!t23);
+                d += right & t23;
+            }
+            p[2] = c;
+            p[3] = d;
+        }
+        p[0] = a;
+        p[1] = b;
+    }
+    if (k == 1) {
+        memcpy(out, p[0], (size_t)(e[0] - p[0]) * sizeof(int));
+        COUNT_MOVE(e[0] - p[0]);
+    }
+}
+
+static void SORT_FN(_PingPongSort)(int arr[], int n, int ways) {
+    if (n <= 1) return;
+    int* temp = n > NET_RUN ? scratch_acquire(n) : NULL;
+    if (n > NET_RUN && !temp) {
+        // ڴ治ʱ˻Ϊԭض
+        SORT_FN(_HeapSort)(arr, n);
+        return;
+    }
+
+    for (int i = 0; i < n; i += NET_RUN) SORT_NETWORK(arr + i, min_val(NET_RUN, n - i));
+
+    int* src = arr;
+    int* dst = temp;
+    for (long long width = NET_RUN; width < n; width *= ways) {
+        for (long long l = 0; l < n; l += width * ways) {
+            const int* p[4];
+            const int* e[4];
+            int k = 0;
+            for (long long lo = l; k < ways && lo < n; lo += width) {
+                p[k] = src + lo;
+                e[k] = src + (lo + width < n ? lo + width : n);
+                k++;
+            }
+            SORT_FN(_PingPongMerge)(p, e, k, dst + l);
+        }
+        int* t = src; src = dst; dst = t;
+    }
+
+    // Ϊʱ temp忽һ
+    if (src != arr) {
+        memcpy(arr, src, (size_t)n * sizeof(int));
+        COUNT_MOVE(n);
+    }
+    if (temp) scratch_release(temp);
+}
+
+void SORT_FN(_PingPongMergeSort)(int arr[], int n) {
+    SORT_FN(_PingPongSort)(arr, n, 2);
+}
+
+void SORT_FN(_PingPongMergeSort4)(int arr[], int n) {
+    SORT_FN(_PingPongSort)(arr, n, 4);
+}
@@ -0,0 +1,128 @@
+// ںģ (ʽ sort_kernels.h ͬ)
+
+// 10. LSD  (32 λз)
+// ÿ˰ 8 λͰ 4 ˡҪ㣺
+//   - һɨͬʱͳ 4 ˵ֱͼ֮Ϊض
+//   - ֽ 0x80 תλȻ֮ǰ
+//   - ĳԪͬһͰʱ˲ı˳ֱ
+//   - ַʱдÿͰһдСС壬д (дϲ)
+//      256 дָͬʱĿд
+// ݺʱֱͼĿռò
+
+static void SORT_FN(_RadixScatter)(const int* src, int* dst, int n, int shift, unsigned flip,
+    int offset[RADIX_BUCKETS], int fill[RADIX_BUCKETS], int* wc) {
+    memset(fill, 0, RADIX_BUCKETS * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        int v = src[i];
+        unsigned b = (((unsigned)v >> shift) & (RADIX_BUCKETS - 1)) ^ flip;
+        int* buf = wc + b * RADIX_WC;
+        buf[fill[b]++] = v;
+        if (fill[b] == RADIX_WC) {
+            memcpy(dst + offset[b], buf, RADIX_WC * sizeof(int));
+            offset[b] += RADIX_WC;
+            fill[b] = 0;
+        }
+    }
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        if (fill[b] > 0) memcpy(dst + offset[b], wc + b * RADIX_WC, (size_t)fill[b] * sizeof(int));
+    }
+    COUNT_MOVE(n);
+}
+
+void SORT_FN(_RadixSort)(int arr[], int n) {
+    if (n < RADIX_MIN_SIZE) {
+        SORT_FN(_InsertSort)(arr, n);
+        return;
+    }
+
+    int* temp = scratch_acquire(n);
+    int* hist = (int*)scratch_alloc(RADIX_PASSES * RADIX_BUCKETS * sizeof(int));
+    int* wc = (int*)scratch_alloc(RADIX_BUCKETS * RADIX_WC * sizeof(int));
+    if (!temp || !hist || !wc) {
+        // ڴ治ʱ˻Ϊԭض
+        if (temp) scratch_release(temp);
+        scratch_free(hist);
+        scratch_free(wc);
+        SORT_FN(_HeapSort)(arr, n);
+        return;
+    }
+    memset(hist, 0, RADIX_PASSES * RADIX_BUCKETS * sizeof(int));
+
+    // ںֱͼһζ
+    for (int i = 0; i < n; i++) {
+        unsigned u = (unsigned)arr[i] ^ 0x80000000u;
+        hist[0 * RADIX_BUCKETS + (u & 0xFF)]++;
+        hist[1 * RADIX_BUCKETS + ((u >> 8) & 0xFF)]++;
+        hist[2 * RADIX_BUCKETS + ((u >> 16) & 0xFF)]++;
+        hist[3 * RADIX_BUCKETS + (u >> 24)]++;
+    }
+
+    int* src = arr;
+    int* dst = temp;
+    int offset[RADIX_BUCKETS];
+    int fill[RADIX_BUCKETS];
+    unsigned first = (unsigned)arr[0] ^ 0x80000000u;
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        int shift = p * RADIX_BITS;
+        const int* h = hist + p * RADIX_BUCKETS;
+        if (h[(first >> shift) & (RADIX_BUCKETS - 1)] == n) continue;   // ȫһͰ
+
+        int sum = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            offset[b] = sum;
+            sum += h[b];
+        }
+        SORT_FN(_RadixScatter)(src, dst, n, shift, p == RADIX_PASSES - 1 ? 0x80u : 0u, offset, fill, wc);
+        g_passes++;
+
+        int* t = src; src = dst; dst = t;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, (size_t)n * sizeof(int));
+        COUNT_MOVE(n);
+    }
+
+    scratch_free(wc);
+    scratch_free(hist);
+    scratch_release(temp);
+}
+
+// 14. 
+// ֵ (max - min + 1) Ԫ COUNTING_MAX_RATIO  (򲻳 COUNTING_MIN_RANGE) ʱ
+// ͳÿֵֵĴֵ˳дأдһ飻ֵʱòʧû
+void SORT_FN(_CountingSort)(int arr[], int n) {
+    if (n < RADIX_MIN_SIZE) {
+        SORT_FN(_InsertSort)(arr, n);
+        return;
+    }
+
+    int lo = arr[0], hi = arr[0];
+    for (int i = 1; i < n; i++) {
+        int v = arr[i];
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+    long long range = (long long)hi - lo + 1;
+    int* count = NULL;
+    if (range <= (long long)n * COUNTING_MAX_RATIO || range <= COUNTING_MIN_RANGE) {
+        count = (int*)scratch_alloc((size_t)range * sizeof(int));
+    }
+    if (!count) {
+        SORT_FN(_RadixSort)(arr, n);
+        return;
+    }
+    memset(count, 0, (size_t)range * sizeof(int));
+
+    // ȥ lo ޷ż㣬ֵԽ int ʱҲ
+    for (int i = 0; i < n; i++) count[(unsigned)arr[i] - (unsigned)lo]++;
+    int k = 0;
+    for (long long v = 0; v < range; v++) {
+        int value = (int)((unsigned)lo + (unsigned)v);
+        for (int c = count[v]; c > 0; c--) arr[k++] = value;
+    }
+    COUNT_MOVE(n);
+    g_passes++;
+
+    scratch_free(count);
+}
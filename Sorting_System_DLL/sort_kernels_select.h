@@ -0,0 +1,135 @@
+// ѡ㷨ںģ (ʽ sort_kernels.h ͬ)
+// ͬһ׺Ȱ _Swap/_InsertSort/_Partition/_HeapAdjustIterative  _PdqSort
+
+// 12.  k С (introselect)
+// ȡкÿ _Partition ֻ֣뺬 k λõһ࣬ O(n)
+// ʧ (Сһ಻ 1/8) Ĵ log2(n) λλѡ׼·֣
+// Ҳ O(n)һʧһָ·֣ظֵʱһųеڻ׼Ԫء
+
+// ·֣غ [low, lt) < pivot[lt, gt] == pivot(gt, high] > pivot
+static void SORT_FN(_Partition3)(int arr[], int low, int high, int pivot, int* lt, int* gt) {
+    int l = low, i = low, g = high;
+    while (i <= g) {
+        COUNT_CMP();
+        if (arr[i] < pivot) {
+            SORT_FN(_Swap)(&arr[l++], &arr[i++]);
+            continue;
+        }
+        COUNT_CMP();
+        if (arr[i] > pivot) SORT_FN(_Swap)(&arr[i], &arr[g--]);
+        else i++;
+    }
+    *lt = l;
+    *gt = g;
+}
+
+static void SORT_FN(_SelectGuarded)(int arr[], int low, int high, int k);
+
+// ÿ 5 һȡλλ俪ͷٵݹЩλλ±
+static int SORT_FN(_MedianOfMedians)(int arr[], int low, int high) {
+    int groups = 0;
+    for (int i = low; i <= high; i += 5) {
+        int len = high - i + 1 < 5 ? high - i + 1 : 5;
+        SORT_FN(_InsertSort)(arr + i, len);
+        SORT_FN(_Swap)(&arr[low + groups], &arr[i + len / 2]);
+        groups++;
+    }
+    int mid = low + (groups - 1) / 2;
+    SORT_FN(_SelectGuarded)(arr, low, low + groups - 1, mid);
+    return mid;
+}
+
+static void SORT_FN(_SelectGuarded)(int arr[], int low, int high, int k) {
+    while (high - low >= SELECT_SMALL) {
+        int p = SORT_FN(_MedianOfMedians)(arr, low, high);
+        int pivot = arr[p]; COUNT_MOVE(1);
+        int lt, gt;
+        SORT_FN(_Partition3)(arr, low, high, pivot, &lt, &gt);
+        if (k < lt) high = lt - 1;
+        else if (k > gt) low = gt + 1;
+        else return;
+    }
+    SORT_FN(_InsertSort)(arr + low, high - low + 1);
+}
+
+// غ arr[k] ΪӦڸλõԪأ඼Ҳ඼С
+void SORT_FN(_NthElement)(int arr[], int n, int k) {
+    int low = 0, high = n - 1;
+    int budget = 0;
+    int threeWay = 0;
+    for (int m = n; m > 1; m >>= 1) budget++;
+
+    while (high - low >= SELECT_SMALL) {
+        // ȡУλ high Ϊ _Partition Ļ׼
+        int mid = low + (high - low) / 2;
+        COUNT_CMP();
+        if (arr[mid] < arr[low]) SORT_FN(_Swap)(&arr[mid], &arr[low]);
+        COUNT_CMP();
+        if (arr[high] < arr[mid]) SORT_FN(_Swap)(&arr[high], &arr[mid]);
+        COUNT_CMP();
+        if (arr[mid] < arr[low]) SORT_FN(_Swap)(&arr[mid], &arr[low]);
+        int unbalanced;
+
+        if (threeWay) {
+            int pivot = arr[mid]; COUNT_MOVE(1);
+            int lt, gt;
+            SORT_FN(_Partition3)(arr, low, high, pivot, &lt, &gt);
+            int smaller = lt - low < high - gt ? lt - low : high - gt;
+            unbalanced = smaller < (high - low + 1) / 8;
+            if (k >= lt && k <= gt) return;
+            if (k < lt) high = lt - 1;
+            else low = gt + 1;
+        }
+        else {
+            SORT_FN(_Swap)(&arr[mid], &arr[high]);
+            int p = SORT_FN(_Partition)(arr, low, high);
+            int smaller = p - low < high - p ? p - low : high - p;
+            unbalanced = smaller < (high - low + 1) / 8;
+            if (k == p) return;
+            if (k < p) high = p - 1;
+            else low = p + 1;
+        }
+        threeWay = unbalanced;
+        if (unbalanced && --budget < 0) {
+            SORT_FN(_SelectGuarded)(arr, low, high, k);
+            return;
+        }
+    }
+    SORT_FN(_InsertSort)(arr + low, high - low + 1);
+}
+
+// 13. 򣺷غ arr[0..k) ΪС k Ԫ˳򲻶
+// k Сʱǰ k ԪϽ󶥶 (_HeapAdjustIterative)ԪСڶѶ滻ѣO(n log k)
+// k  n / PARTIAL_HEAP_RATIOѴ (룬ÿԪضҪ) ʱ
+// Ϊ _NthElement ٶǰ k  pdqsort
+static void SORT_FN(_PartialSelect)(int arr[], int n, int k) {
+    if (k < n) SORT_FN(_NthElement)(arr, n, k - 1);
+    SORT_FN(_PdqSort)(arr, k);
+}
+
+void SORT_FN(_PartialSort)(int arr[], int n, int k) {
+    if (k > n) k = n;
+    if (k <= 0 || n < 2) return;
+    if (k > n / PARTIAL_HEAP_RATIO) {
+        SORT_FN(_PartialSelect)(arr, n, k);
+        return;
+    }
+    int limit = n / PARTIAL_REPLACE_RATIO + k;
+    int replaced = 0;
+    for (int i = k / 2 - 1; i >= 0; i--) SORT_FN(_HeapAdjustIterative)(arr, k, i);
+    for (int i = k; i < n; i++) {
+        COUNT_CMP();
+        if (arr[i] < arr[0]) {
+            if (++replaced > limit) {
+                SORT_FN(_PartialSelect)(arr, n, k);
+                return;
+            }
+            SORT_FN(_Swap)(&arr[0], &arr[i]);
+            SORT_FN(_HeapAdjustIterative)(arr, k, 0);
+        }
+    }
+    for (int i = k - 1; i > 0; i--) {
+        SORT_FN(_Swap)(&arr[0], &arr[i]);
+        SORT_FN(_HeapAdjustIterative)(arr, i, 0);
+    }
+}
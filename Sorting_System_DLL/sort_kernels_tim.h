@@ -0,0 +1,364 @@
+// Ӧ鲢ںģ (ʽ sort_kernels.h ͬ)
+
+// 12. Ӧ鲢 (TimSort)
+// е (run)
+//   - ʶΣϸԭطת (ϸ֤ȶ)
+//   -  minRun Ķöֲ򲹵 minRun
+//   - ѹջά len[i-2] > len[i-1] + len[i]  len[i-1] > len[i]֤鲢
+//   - 鲢ʱ gallop Ѿλǰ׺ֻɽ϶̵һΣ
+//     ĳһʤκ galloping ģʽɿ鸴
+// 붼ֻһΣO(n) 
+
+// ֤ need Ԫ
+static int* SORT_FN(_TimBuffer)(TimState* ts, int need) {
+    if (ts->bufCap >= need) return ts->buf;
+    if (g_ctx && g_ctx->scratch && g_ctx->scratchCapacity >= need) {
+        if (ts->bufOwned) scratch_free(ts->buf);
+        ts->buf = g_ctx->scratch;
+        ts->bufCap = g_ctx->scratchCapacity;
+        ts->bufOwned = 0;
+        return ts->buf;
+    }
+    int cap = ts->bufCap * 2 > need ? ts->bufCap * 2 : need;
+    if (cap > ts->n / 2 + 1) cap = ts->n / 2 + 1;
+    if (cap < need) cap = need;
+    int* p = (int*)scratch_alloc((size_t)cap * sizeof(int));
+    if (!p) return NULL;
+    if (ts->bufOwned) scratch_free(ts->buf);
+    ts->buf = p;
+    ts->bufCap = cap;
+    ts->bufOwned = 1;
+    return p;
+}
+
+// ʶ lo ʼĶΣתضγ
+static int SORT_FN(_TimCountRun)(int arr[], int lo, int hi) {
+    int runHi = lo + 1;
+    if (runHi == hi) return 1;
+    COUNT_CMP();
+    if (arr[runHi++] < arr[lo]) {
+        while (runHi < hi && (COUNT_CMP(), arr[runHi] < arr[runHi - 1])) runHi++;
+        for (int i = lo, j = runHi - 1; i < j; i++, j--) SORT_FN(_Swap)(&arr[i], &arr[j]);
+    }
+    else {
+        while (runHi < hi && (COUNT_CMP(), arr[runHi] >= arr[runHi - 1])) runHi++;
+    }
+    return runHi - lo;
+}
+
+// ֲ[lo, start) 򣬰 [start, hi) 
+static void SORT_FN(_TimBinaryInsert)(int arr[], int lo, int hi, int start) {
+    for (; start < hi; start++) {
+        int pivot = arr[start]; COUNT_MOVE(1);
+        int left = lo, right = start;
+        while (left < right) {
+            int mid = left + (right - left) / 2;
+            COUNT_CMP();
+            if (pivot < arr[mid]) right = mid;
+            else left = mid + 1;
+        }
+        memmove(&arr[left + 1], &arr[left], (size_t)(start - left) * sizeof(int));
+        arr[left] = pivot;
+        COUNT_MOVE(start - left + 1);
+    }
+}
+
+//  a[0..len)  key Ĳ (ʱ) hint ָ̽
+static int SORT_FN(_TimGallopLeft)(int key, const int* a, int len, int hint) {
+    int lastOfs = 0, ofs = 1;
+    COUNT_CMP();
+    if (key > a[hint]) {
+        int maxOfs = len - hint;
+        while (ofs < maxOfs && (COUNT_CMP(), key > a[hint + ofs])) {
+            lastOfs = ofs;
+            ofs = ofs < maxOfs / 2 ? (ofs << 1) + 1 : maxOfs;
+        }
+        if (ofs > maxOfs) ofs = maxOfs;
+        lastOfs += hint;
+        ofs += hint;
+    }
+    else {
+        int maxOfs = hint + 1;
+        while (ofs < maxOfs && (COUNT_CMP(), key <= a[hint - ofs])) {
+            lastOfs = ofs;
+            ofs = ofs < maxOfs / 2 ? (ofs << 1) + 1 : maxOfs;
+        }
+        if (ofs > maxOfs) ofs = maxOfs;
+        int t = lastOfs;
+        lastOfs = hint - ofs;
+        ofs = hint - t;
+    }
+    lastOfs++;
+    while (lastOfs < ofs) {
+        int m = lastOfs + (ofs - lastOfs) / 2;
+        COUNT_CMP();
+        if (key > a[m]) lastOfs = m + 1;
+        else ofs = m;
+    }
+    return ofs;
+}
+
+// ͬϣʱ
+static int SORT_FN(_TimGallopRight)(int key, const int* a, int len, int hint) {
+    int lastOfs = 0, ofs = 1;
+    COUNT_CMP();
+    if (key < a[hint]) {
+        int maxOfs = hint + 1;
+        while (ofs < maxOfs && (COUNT_CMP(), key < a[hint - ofs])) {
+            lastOfs = ofs;
+            ofs = ofs < maxOfs / 2 ? (ofs << 1) + 1 : maxOfs;
+        }
+        if (ofs > maxOfs) ofs = maxOfs;
+        int t = lastOfs;
+        lastOfs = hint - ofs;
+        ofs = hint - t;
+    }
+    else {
+        int maxOfs = len - hint;
+        while (ofs < maxOfs && (COUNT_CMP(), key >= a[hint + ofs])) {
+            lastOfs = ofs;
+            ofs = ofs < maxOfs / 2 ? (ofs << 1) + 1 : maxOfs;
+        }
+        if (ofs > maxOfs) ofs = maxOfs;
+        lastOfs += hint;
+        ofs += hint;
+    }
+    lastOfs++;
+    while (lastOfs < ofs) {
+        int m = lastOfs + (ofs - lastOfs) / 2;
+        COUNT_CMP();
+        if (key < a[m]) ofs = m;
+        else lastOfs = m + 1;
+    }
+    return ofs;
+}
+
+#define TIM_COPY(dst, src, k) (memmove((dst), (src), (size_t)(k) * sizeof(int)), COUNT_MOVE(k))
+
+// ν϶̣θƵ壬ǰ鲢
+static void SORT_FN(_TimMergeLo)(TimState* ts, int base1, int len1, int base2, int len2) {
+    int* a = ts->arr;
+    int* tmp = SORT_FN(_TimBuffer)(ts, len1);
+    if (!tmp) {
+        // ʧʱ˻Ϊԭضֲ
+        SORT_FN(_TimBinaryInsert)(a, base1, base2 + len2, base2);
+        return;
+    }
+    TIM_COPY(tmp, a + base1, len1);
+    int c1 = 0, c2 = base2, dest = base1;
+
+    a[dest++] = a[c2++]; COUNT_MOVE(1);
+    if (--len2 == 0) { TIM_COPY(a + dest, tmp + c1, len1); return; }
+    if (len1 == 1) { TIM_COPY(a + dest, a + c2, len2); a[dest + len2] = tmp[c1]; COUNT_MOVE(1); return; }
+
+    int minGallop = ts->minGallop;
+    for (;;) {
+        int count1 = 0, count2 = 0;
+        // Ƚϣֱĳһʤ minGallop 
+        do {
+            COUNT_CMP();
+            if (a[c2] < tmp[c1]) {
+                a[dest++] = a[c2++]; COUNT_MOVE(1);
+                count2++; count1 = 0;
+                if (--len2 == 0) goto done;
+            }
+            else {
+                a[dest++] = tmp[c1++]; COUNT_MOVE(1);
+                count1++; count2 = 0;
+                if (--len1 == 1) goto done;
+            }
+        } while ((count1 | count2) < minGallop);
+
+        // gallopingɿ鸴ƣֱζʤ
+        do {
+            count1 = SORT_FN(_TimGallopRight)(a[c2], tmp + c1, len1, 0);
+            if (count1 != 0) {
+                TIM_COPY(a + dest, tmp + c1, count1);
+                dest += count1; c1 += count1; len1 -= count1;
+                if (len1 <= 1) goto done;
+            }
+            a[dest++] = a[c2++]; COUNT_MOVE(1);
+            if (--len2 == 0) goto done;
+
+            count2 = SORT_FN(_TimGallopLeft)(tmp[c1], a + c2, len2, 0);
+            if (count2 != 0) {
+                TIM_COPY(a + dest, a + c2, count2);
+                dest += count2; c2 += count2; len2 -= count2;
+                if (len2 == 0) goto done;
+            }
+            a[dest++] = tmp[c1++]; COUNT_MOVE(1);
+            if (--len1 == 1) goto done;
+            minGallop--;
+        } while (count1 >= TIM_MIN_GALLOP || count2 >= TIM_MIN_GALLOP);
+        if (minGallop < 0) minGallop = 0;
+        minGallop += 2;   // ˳ gallopingٴνż
+    }
+done:
+    ts->minGallop = minGallop < 1 ? 1 : minGallop;
+    if (len1 == 1) {
+        TIM_COPY(a + dest, a + c2, len2);
+        a[dest + len2] = tmp[c1]; COUNT_MOVE(1);
+    }
+    else if (len1 > 0) {
+        TIM_COPY(a + dest, tmp + c1, len1);
+    }
+}
+
+// Ҷν϶̣ҶθƵ壬Ӻǰ鲢
+static void SORT_FN(_TimMergeHi)(TimState* ts, int base1, int len1, int base2, int len2) {
+    int* a = ts->arr;
+    int* tmp = SORT_FN(_TimBuffer)(ts, len2);
+    if (!tmp) {
+        SORT_FN(_TimBinaryInsert)(a, base1, base2 + len2, base2);
+        return;
+    }
+    TIM_COPY(tmp, a + base2, len2);
+    int c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;
+
+    a[dest--] = a[c1--]; COUNT_MOVE(1);
+    if (--len1 == 0) { TIM_COPY(a + dest - (len2 - 1), tmp, len2); return; }
+    if (len2 == 1) {
+        dest -= len1; c1 -= len1;
+        TIM_COPY(a + dest + 1, a + c1 + 1, len1);
+        a[dest] = tmp[c2]; COUNT_MOVE(1);
+        return;
+    }
+
+    int minGallop = ts->minGallop;
+    for (;;) {
+        int count1 = 0, count2 = 0;
+        do {
+            COUNT_CMP();
+            if (tmp[c2] < a[c1]) {
+                a[dest--] = a[c1--]; COUNT_MOVE(1);
+                count1++; count2 = 0;
+                if (--len1 == 0) goto done;
+            }
+            else {
+                a[dest--] = tmp[c2--]; COUNT_MOVE(1);
+                count2++; count1 = 0;
+                if (--len2 == 1) goto done;
+            }
+        } while ((count1 | count2) < minGallop);
+
+        do {
+            count1 = len1 - SORT_FN(_TimGallopRight)(tmp[c2], a + base1, len1, len1 - 1);
+            if (count1 != 0) {
+                dest -= count1; c1 -= count1; len1 -= count1;
+                TIM_COPY(a + dest + 1, a + c1 + 1, count1);
+                if (len1 == 0) goto done;
+            }
+            a[dest--] = tmp[c2--]; COUNT_MOVE(1);
+            if (--len2 == 1) goto done;
+
+            count2 = len2 - SORT_FN(_TimGallopLeft)(a[c1], tmp, len2, len2 - 1);
+            if (count2 != 0) {
+                dest -= count2; c2 -= count2; len2 -= count2;
+                TIM_COPY(a + dest + 1, tmp + c2 + 1, count2);
+                if (len2 <= 1) goto done;
+            }
+            a[dest--] = a[c1--]; COUNT_MOVE(1);
+            if (--len1 == 0) goto done;
+            minGallop--;
+        } while (count1 >= TIM_MIN_GALLOP || count2 >= TIM_MIN_GALLOP);
+        if (minGallop < 0) minGallop = 0;
+        minGallop += 2;
+    }
+done:
+    ts->minGallop = minGallop < 1 ? 1 : minGallop;
+    if (len2 == 1) {
+        dest -= len1; c1 -= len1;
+        TIM_COPY(a + dest + 1, a + c1 + 1, len1);
+        a[dest] = tmp[c2]; COUNT_MOVE(1);
+    }
+    else if (len2 > 0) {
+        TIM_COPY(a + dest - (len2 - 1), tmp, len2);
+    }
+}
+
+#undef TIM_COPY
+
+// 鲢ջе i  i+1 
+static void SORT_FN(_TimMergeAt)(TimState* ts, int i) {
+    int* a = ts->arr;
+    int base1 = ts->runs[i].base, len1 = ts->runs[i].len;
+    int base2 = ts->runs[i + 1].base, len2 = ts->runs[i + 1].len;
+
+    ts->runs[i].len = len1 + len2;
+    if (i == ts->runCount - 3) ts->runs[i + 1] = ts->runs[i + 2];
+    ts->runCount--;
+
+    // в a[base2] ǰ׺ҶвСĩβĺ׺Ѿλ
+    int k = SORT_FN(_TimGallopRight)(a[base2], a + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0) return;
+    len2 = SORT_FN(_TimGallopLeft)(a[base1 + len1 - 1], a + base2, len2, len2 - 1);
+    if (len2 == 0) return;
+
+    if (len1 <= len2) SORT_FN(_TimMergeLo)(ts, base1, len1, base2, len2);
+    else SORT_FN(_TimMergeHi)(ts, base1, len1, base2, len2);
+}
+
+// ָջʽ
+static void SORT_FN(_TimMergeCollapse)(TimState* ts) {
+    const TimRun* r = ts->runs;
+    while (ts->runCount > 1) {
+        int k = ts->runCount - 2;
+        if ((k > 0 && r[k - 1].len <= r[k].len + r[k + 1].len) ||
+            (k > 1 && r[k - 2].len <= r[k - 1].len + r[k].len)) {
+            if (r[k - 1].len < r[k + 1].len) k--;
+        }
+        else if (r[k].len > r[k + 1].len) {
+            break;
+        }
+        SORT_FN(_TimMergeAt)(ts, k);
+    }
+}
+
+void SORT_FN(_TimSort)(int arr[], int n) {
+    if (n < 2) return;
+    if (n < TIM_MIN_MERGE) {
+        int run = SORT_FN(_TimCountRun)(arr, 0, n);
+        SORT_FN(_TimBinaryInsert)(arr, 0, n, run);
+        return;
+    }
+
+    TimState ts;
+    memset(&ts, 0, sizeof(ts));
+    ts.arr = arr;
+    ts.n = n;
+    ts.minGallop = TIM_MIN_GALLOP;
+
+    // minRun ȡ n ĸ 5 λ (ĩλʱһ)ʹ n / minRun ӽ 2 
+    int minRun = n, r = 0;
+    while (minRun >= TIM_MIN_MERGE) {
+        r |= minRun & 1;
+        minRun >>= 1;
+    }
+    minRun += r;
+
+    int lo = 0, remaining = n;
+    while (remaining > 0) {
+        int run = SORT_FN(_TimCountRun)(arr, lo, n);
+        if (run < minRun) {
+            int force = remaining <= minRun ? remaining : minRun;
+            SORT_FN(_TimBinaryInsert)(arr, lo, lo + force, lo + run);
+            run = force;
+        }
+        ts.runs[ts.runCount].base = lo;
+        ts.runs[ts.runCount].len = run;
+        ts.runCount++;
+        SORT_FN(_TimMergeCollapse)(&ts);
+        lo += run;
+        remaining -= run;
+    }
+
+    while (ts.runCount > 1) {
+        int k = ts.runCount - 2;
+        if (k > 0 && ts.runs[k - 1].len < ts.runs[k + 1].len) k--;
+        SORT_FN(_TimMergeAt)(&ts, k);
+    }
+
+    if (ts.bufOwned) scratch_free(ts.buf);
+}
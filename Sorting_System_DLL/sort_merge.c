@@ -0,0 +1,247 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ·鲢 k ϲΪһ
+// ÿ 64 λϼ (ֵ |  | ±)һȽϼɾʤ
+// ʱ±С (ȶ)Ԫ֮󣬲Ҫ֧
+// аȰλ (co-ranking) ÿг P Σ̶߳鲢
+
+#define KM_PAR_MIN 65536         // ùģʱ
+#define KM_STACK_K 64            // k ֵʱջ
+
+// 1. ·޷֧ϲ
+static long long merge2(const int* a, int na, const int* b, int nb, int* out) {
+    int i = 0, j = 0;
+    long long cmp = 0;
+    while (i < na && j < nb) {
+        int x = a[i], y = b[j];
+        int takeB = y < x;
+        *out++ = takeB ? y : x;
+        j += takeB;
+        i += !takeB;
+        cmp++;
+    }
+    memcpy(out, a + i, (size_t)(na - i) * sizeof(int));
+    memcpy(out + (na - i), b + j, (size_t)(nb - j) * sizeof(int));
+    return cmp;
+}
+
+// 2. 
+static unsigned long long km_key(int value, int done, int src) {
+    return ((unsigned long long)((unsigned)value ^ 0x80000000u) << 32) | ((unsigned long long)done << 31) | (unsigned)src;
+}
+
+// tree Ҫ 3k λãtree[1..k) Ϊİߣtree[0] Ϊʤߣ
+// ʱ tree[k..2k) Ҷӣtree[2k..3k) ݴʤ
+static long long merge_k(const SortSpan* in, int k, int* out, int* pos, unsigned long long* tree) {
+    long long total = 0, cmp = 0;
+    for (int i = 0; i < k; i++) {
+        pos[i] = 0;
+        total += in[i].length;
+        tree[k + i] = in[i].length > 0 ? km_key(in[i].data[0], 0, i) : km_key(0x7fffffff, 1, i);
+    }
+    // ԵϽ
+    unsigned long long* winners = tree + 2 * k;
+    for (int i = k - 1; i >= 1; i--) {
+        unsigned long long a = 2 * i >= k ? tree[2 * i] : winners[2 * i];
+        unsigned long long b = 2 * i + 1 >= k ? tree[2 * i + 1] : winners[2 * i + 1];
+        cmp++;
+        if (b < a) { winners[i] = b; tree[i] = a; }
+        else { winners[i] = a; tree[i] = b; }
+    }
+    tree[0] = k > 1 ? winners[1] : tree[k];
+
+    for (long long o = 0; o < total; o++) {
+        unsigned long long w = tree[0];
+        int src = (int)(w & 0x7fffffffu);
+        out[o] = (int)((unsigned)(w >> 32) ^ 0x80000000u);
+        int p = ++pos[src];
+        w = p < in[src].length ? km_key(in[src].data[p], 0, src) : km_key(0x7fffffff, 1, src);
+        // ҶԼ log2(k) αȽϣʤѡ֧
+        for (int node = (src + k) >> 1; node >= 1; node >>= 1) {
+            unsigned long long l = tree[node];
+            int lose = l < w;
+            tree[node] = lose ? w : l;
+            w = lose ? l : w;
+            cmp++;
+        }
+        tree[0] = w;
+    }
+    return cmp;
+}
+
+// ϲ k  ()رȽϴ
+static long long merge_spans(const SortSpan* in, int k, int* out) {
+    if (k == 0) return 0;
+    if (k == 1) {
+        memcpy(out, in[0].data, (size_t)in[0].length * sizeof(int));
+        return 0;
+    }
+    if (k == 2) return merge2(in[0].data, in[0].length, in[1].data, in[1].length, out);
+
+    int posStack[KM_STACK_K];
+    unsigned long long treeStack[3 * KM_STACK_K];
+    int* pos = posStack;
+    unsigned long long* tree = treeStack;
+    if (k > KM_STACK_K) {
+        pos = (int*)malloc((size_t)k * sizeof(int));
+        tree = (unsigned long long*)malloc((size_t)(3 * k) * sizeof(unsigned long long));
+        if (!pos || !tree) {
+            free(pos); free(tree);
+            return -1;
+        }
+    }
+    long long cmp = merge_k(in, k, out, pos, tree);
+    if (k > KM_STACK_K) {
+        free(pos);
+        free(tree);
+    }
+    return cmp;
+}
+
+// 3. ÿзֵ cut[i]ʹ sum(cut) == rank зֵ֮ǰԪض֮
+// ȶֳ rank Ԫصֵ vȡС v Ԫأ㲿ְ±˳򲹵 v Ԫ
+static int lower_bound(const int* a, int n, int v) {
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (a[mid] < v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int upper_bound(const int* a, int n, int v) {
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (a[mid] <= v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void co_rank(const SortSpan* in, int k, long long rank, int* cut) {
+    // С v ʹ count(<= v) > rank
+    long long lo = -2147483648LL, hi = 2147483647LL;
+    while (lo < hi) {
+        long long mid = lo + ((hi - lo) >> 1);
+        long long c = 0;
+        for (int i = 0; i < k; i++) c += upper_bound(in[i].data, in[i].length, (int)mid);
+        if (c > rank) hi = mid;
+        else lo = mid + 1;
+    }
+    int v = (int)lo;
+    long long need = rank;
+    for (int i = 0; i < k; i++) {
+        cut[i] = lower_bound(in[i].data, in[i].length, v);
+        need -= cut[i];
+    }
+    for (int i = 0; i < k && need > 0; i++) {
+        int equal = upper_bound(in[i].data, in[i].length, v) - cut[i];
+        int take = need < equal ? (int)need : equal;
+        cut[i] += take;
+        need -= take;
+    }
+}
+
+typedef struct {
+    const SortSpan* in;
+    int k;
+    int* out;
+    int pieces;
+    long long total;
+    int* cuts;               // (pieces + 1) * k зֵ
+    long long cmp[POOL_MAX_THREADS];
+    int failed;
+} KMergeJob;
+
+static void cut_piece(void* arg, int index) {
+    KMergeJob* job = (KMergeJob*)arg;
+    co_rank(job->in, job->k, job->total * (index + 1) / job->pieces, job->cuts + (size_t)(index + 1) * job->k);
+}
+
+static void merge_piece(void* arg, int index) {
+    KMergeJob* job = (KMergeJob*)arg;
+    int k = job->k;
+    const int* lo = job->cuts + (size_t)index * k;
+    const int* hi = lo + k;
+    SortSpan stackSpans[KM_STACK_K];
+    SortSpan* sub = k > KM_STACK_K ? (SortSpan*)malloc((size_t)k * sizeof(SortSpan)) : stackSpans;
+    if (!sub) { job->failed = 1; return; }
+    long long offset = 0;
+    for (int i = 0; i < k; i++) {
+        sub[i].data = job->in[i].data + lo[i];
+        sub[i].length = hi[i] - lo[i];
+        offset += lo[i];
+    }
+    long long cmp = merge_spans(sub, k, job->out + offset);
+    if (cmp < 0) job->failed = 1;
+    else job->cmp[index] = cmp;
+    if (sub != stackSpans) free(sub);
+}
+
+// 4. ӿ
+static long long check_spans(const SortSpan* inputs, int k, const int* out) {
+    if (k < 0 || (k > 0 && (!inputs || !out))) return -1;
+    long long total = 0;
+    for (int i = 0; i < k; i++) {
+        if (inputs[i].length < 0 || (inputs[i].length > 0 && !inputs[i].data)) return -1;
+        total += inputs[i].length;
+    }
+    return total;
+}
+
+static void fill_stats(SortPerformance* stats, const char* name, long long total, long long cmp, double ms) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    snprintf(stats->algorithm, sizeof(stats->algorithm), "%s", name);
+    stats->dataSize = total > 0x7fffffff ? 0x7fffffff : (int)total;
+    stats->compareCount = cmp;
+    stats->moveCount = total;
+    stats->timeCost = ms;
+}
+
+EXPORT int kway_merge(const SortSpan* inputs, int k, int* out, SortPerformance* stats) {
+    long long total = check_spans(inputs, k, out);
+    if (total < 0) return -1;
+    double start = get_time_ms();
+    long long cmp = merge_spans(inputs, k, out);
+    if (cmp < 0) return -1;
+    fill_stats(stats, "K-way Merge", total, cmp, get_time_ms() - start);
+    return 0;
+}
+
+EXPORT int parallel_kway_merge(const SortSpan* inputs, int k, int* out, int threads, SortPerformance* stats) {
+    long long total = check_spans(inputs, k, out);
+    if (total < 0) return -1;
+    if (threads <= 0) threads = pool_hardware_threads();
+    if (threads > POOL_MAX_THREADS) threads = POOL_MAX_THREADS;
+    if (total < KM_PAR_MIN || k < 2) threads = 1;
+
+    double start = get_time_ms();
+    KMergeJob job;
+    job.in = inputs;
+    job.k = k;
+    job.out = out;
+    job.pieces = threads;
+    job.total = total;
+    job.failed = 0;
+    job.cuts = (int*)calloc((size_t)(threads + 1) * (size_t)k, sizeof(int));
+    if (!job.cuts) return -1;
+    memset(job.cmp, 0, sizeof(job.cmp));
+
+    // βзֵ֪ȫ 0 볤ȣмĸԶ
+    for (int i = 0; i < k; i++) job.cuts[(size_t)threads * k + i] = inputs[i].length;
+    pool_parallel_for(threads - 1, threads, cut_piece, &job);
+    pool_parallel_for(threads, threads, merge_piece, &job);
+    free(job.cuts);
+    if (job.failed) return -1;
+
+    long long cmp = 0;
+    for (int t = 0; t < threads; t++) cmp += job.cmp[t];
+    fill_stats(stats, "Parallel K-way Merge", total, cmp, get_time_ms() - start);
+    return 0;
+}
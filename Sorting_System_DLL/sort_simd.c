@@ -0,0 +1,228 @@
+#include "sort_internal.h"
+#include <limits.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// С SIMD ָɡ
+// 籾д sort_simd_network.h УΪ SSE4.1 / AVX2 / AVX-512 ʵһݣ
+// ״ʹʱ CPUID ѡõָ
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSE41
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#else
+#define SIMD_X86 0
+#endif
+
+// 1. ָʵ
+#if SIMD_X86
+
+// SSE4.14 ·lane  pshufb ֽ±
+#define SIMD_FN(name) name##Sse41
+#define SIMD_TARGET TARGET_SSE41
+#define SIMD_W 4
+#define SIMD_LOG 2
+#define VEC __m128i
+#define VLOAD(p) _mm_loadu_si128((const __m128i*)(p))
+#define VSTORE(p, v) _mm_storeu_si128((__m128i*)(p), v)
+#define VMIN(a, b) _mm_min_epi32(a, b)
+#define VMAX(a, b) _mm_max_epi32(a, b)
+#define VPERM(v, p) _mm_shuffle_epi8(v, VLOAD(p))
+#define VBLEND(a, b, p) _mm_blendv_epi8(a, b, VLOAD(p))
+#define VIDX_ENC(l) ((4 * (l)) | ((4 * (l) + 1) << 8) | ((4 * (l) + 2) << 16) | ((4 * (l) + 3) << 24))
+#include "sort_simd_network.h"
+#undef SIMD_FN
+#undef SIMD_TARGET
+#undef SIMD_W
+#undef SIMD_LOG
+#undef VEC
+#undef VLOAD
+#undef VSTORE
+#undef VMIN
+#undef VMAX
+#undef VPERM
+#undef VBLEND
+#undef VIDX_ENC
+
+// AVX28 · lane  vpermd
+#define SIMD_FN(name) name##Avx2
+#define SIMD_TARGET TARGET_AVX2
+#define SIMD_W 8
+#define SIMD_LOG 3
+#define VEC __m256i
+#define VLOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define VSTORE(p, v) _mm256_storeu_si256((__m256i*)(p), v)
+#define VMIN(a, b) _mm256_min_epi32(a, b)
+#define VMAX(a, b) _mm256_max_epi32(a, b)
+#define VPERM(v, p) _mm256_permutevar8x32_epi32(v, VLOAD(p))
+#define VBLEND(a, b, p) _mm256_blendv_epi8(a, b, VLOAD(p))
+#define VIDX_ENC(l) (l)
+#include "sort_simd_network.h"
+#undef SIMD_FN
+#undef SIMD_TARGET
+#undef SIMD_W
+#undef SIMD_LOG
+#undef VEC
+#undef VLOAD
+#undef VSTORE
+#undef VMIN
+#undef VMAX
+#undef VPERM
+#undef VBLEND
+#undef VIDX_ENC
+
+// AVX-512F16 ·ɱеķλ
+#define SIMD_FN(name) name##Avx512
+#define SIMD_TARGET TARGET_AVX512
+#define SIMD_W 16
+#define SIMD_LOG 4
+#define VEC __m512i
+#define VLOAD(p) _mm512_loadu_si512((const void*)(p))
+#define VSTORE(p, v) _mm512_storeu_si512((void*)(p), v)
+#define VMIN(a, b) _mm512_min_epi32(a, b)
+#define VMAX(a, b) _mm512_max_epi32(a, b)
+#define VPERM(v, p) _mm512_permutexvar_epi32(VLOAD(p), v)
+#define VBLEND(a, b, p) _mm512_mask_blend_epi32(_mm512_cmplt_epi32_mask(VLOAD(p), _mm512_setzero_si512()), a, b)
+#define VIDX_ENC(l) (l)
+#include "sort_simd_network.h"
+#undef SIMD_FN
+#undef SIMD_TARGET
+#undef SIMD_W
+#undef SIMD_LOG
+#undef VEC
+#undef VLOAD
+#undef VSTORE
+#undef VMIN
+#undef VMAX
+#undef VPERM
+#undef VBLEND
+#undef VIDX_ENC
+
+#endif // SIMD_X86
+
+// 2. CPUID 
+static int detect_level(void) {
+#if SIMD_X86 && defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    int maxLeaf = r[0];
+    __cpuid(r, 1);
+    int sse41 = (r[2] >> 19) & 1;
+    int osxsave = (r[2] >> 27) & 1;
+    int avx = (r[2] >> 28) & 1;
+    if (!sse41) return SORT_SIMD_NONE;
+    if (!osxsave || !avx || maxLeaf < 7) return SORT_SIMD_SSE41;
+    unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6) return SORT_SIMD_SSE41;           // ϵͳδ YMM ״̬
+    __cpuidex(r, 7, 0);
+    int avx2 = (r[1] >> 5) & 1;
+    int avx512f = (r[1] >> 16) & 1;
+    if (avx512f && (xcr0 & 0xE6) == 0xE6) return SORT_SIMD_AVX512;
+    return avx2 ? SORT_SIMD_AVX2 : SORT_SIMD_SSE41;
+#elif SIMD_X86
+    // GCC/Clang ļͬȷϲϵͳöӦĴ״̬
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SORT_SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SORT_SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SORT_SIMD_SSE41;
+    return SORT_SIMD_NONE;
+#else
+    return SORT_SIMD_NONE;
+#endif
+}
+
+// 3. һԳʼָɸʵű
+static int g_simdDetected = SORT_SIMD_NONE;
+static volatile int g_simdLevel = SORT_SIMD_NONE;   // ǰʹõָɱ sort_simd_set_level 
+
+static void simd_init_once(void) {
+#if SIMD_X86
+    _InitSse41();
+    _InitAvx2();
+    _InitAvx512();
+#endif
+    g_simdDetected = detect_level();
+    g_simdLevel = g_simdDetected;
+}
+
+#ifdef _WIN32
+static INIT_ONCE g_simdOnce = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK simd_init_callback(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once; (void)param; (void)ctx;
+    simd_init_once();
+    return TRUE;
+}
+static void simd_init(void) { InitOnceExecuteOnce(&g_simdOnce, simd_init_callback, NULL, NULL); }
+#else
+static pthread_once_t g_simdOnce = PTHREAD_ONCE_INIT;
+static void simd_init(void) { pthread_once(&g_simdOnce, simd_init_once); }
+#endif
+
+// 4. 󱸣ִ˫֧̫࣬
+static void scalar_insert(int* a, int n) {
+    for (int i = 1; i < n; i++) {
+        int t = a[i], j = i - 1;
+        while (j >= 0 && a[j] > t) { a[j + 1] = a[j]; j--; }
+        a[j + 1] = t;
+    }
+}
+
+//  2 ݳ n (4 <= n <= SIMD_NET_MAX)ѡĴȲ n ߿ָ
+static void network_pow2(int* a, int n) {
+#if SIMD_X86
+    int level = g_simdLevel;
+    if (level >= SORT_SIMD_AVX512 && n >= 16) { _SortAvx512(a, n); return; }
+    if (level >= SORT_SIMD_AVX2 && n >= 8) { _SortAvx2(a, n); return; }
+    _SortSse41(a, n);
+#else
+    (void)a; (void)n;
+#endif
+}
+
+// 5. ӿ
+void simd_network_sort(int* a, int n) {
+    if (n < 2) return;
+    simd_init();
+    if (g_simdLevel == SORT_SIMD_NONE) {
+        scalar_insert(a, n);
+        return;
+    }
+    int size = 4;
+    while (size < n) size <<= 1;
+    if (size == n) {
+        network_pow2(a, n);
+        return;
+    }
+    //  2 ʱ INT_MAXֻȡǰ n 
+    int buf[SIMD_NET_MAX];
+    memcpy(buf, a, (size_t)n * sizeof(int));
+    for (int i = n; i < size; i++) buf[i] = INT_MAX;
+    network_pow2(buf, size);
+    memcpy(a, buf, (size_t)n * sizeof(int));
+}
+
+EXPORT int sort_simd_level(void) {
+    simd_init();
+    return g_simdLevel;
+}
+
+EXPORT int sort_simd_set_level(int level) {
+    simd_init();
+    if (level < SORT_SIMD_NONE) level = SORT_SIMD_NONE;
+    g_simdLevel = level < g_simdDetected ? level : g_simdDetected;
+    return g_simdLevel;
+}
@@ -0,0 +1,91 @@
+// SIMD ģ
+// ļû include guardsort_simd.c ΪÿָһΡǰ趨壺
+//   SIMD_FN(name)        Σ name##Avx2
+//   SIMD_TARGET           (GCC/Clang  targetMSVC Ϊ)
+//   SIMD_W / SIMD_LOG    ÿĴ int  log2
+//   VEC                  
+//   VLOAD(p)/VSTORE(p,v) Ƕд
+//   VMIN(a,b)/VMAX(a,b)   lane ȡС/ȡ
+//   VPERM(v,p)            p  lane ( VIDX_ENC )
+//   VBLEND(a,b,p)         p ѡp Ӧ lane Ϊ -1 ȡ bȡ a
+//   VIDX_ENC(l)           lane ± VPERM ĸʽ
+//
+// "ȫȽ"ʽ˫磺ģ s ÿһ뾵λñȽ (ת)
+//  s/4 ... 1 λñȽϡһĴʱֱ min/max
+// ͬһĴʱȰų min/maxȡء
+
+// ĴڸĻ룺ǰ SIMD_LOG Ϊת (s = 2..W) SIMD_LOG Ϊ d = 1..W/2
+static int SIMD_FN(g_perm)[2 * SIMD_LOG][SIMD_W];
+static int SIMD_FN(g_mask)[2 * SIMD_LOG][SIMD_W];
+static int SIMD_FN(g_rev)[SIMD_W];
+
+static void SIMD_FN(_Init)(void) {
+    for (int k = 0; k < SIMD_LOG; k++) {
+        int s = 2 << k;
+        int d = 1 << k;
+        for (int l = 0; l < SIMD_W; l++) {
+            int pf = l ^ (s - 1);
+            int px = l ^ d;
+            SIMD_FN(g_perm)[k][l] = VIDX_ENC(pf);
+            SIMD_FN(g_mask)[k][l] = pf < l ? -1 : 0;   // ±һȡϴֵ
+            SIMD_FN(g_perm)[SIMD_LOG + k][l] = VIDX_ENC(px);
+            SIMD_FN(g_mask)[SIMD_LOG + k][l] = px < l ? -1 : 0;
+        }
+    }
+    for (int l = 0; l < SIMD_W; l++) SIMD_FN(g_rev)[l] = VIDX_ENC(SIMD_W - 1 - l);
+}
+
+// ĴڵһȽϽ
+static SIMD_TARGET VEC SIMD_FN(_Layer)(VEC v, int layer) {
+    VEC p = VPERM(v, SIMD_FN(g_perm)[layer]);
+    return VBLEND(VMIN(v, p), VMAX(v, p), SIMD_FN(g_mask)[layer]);
+}
+
+// ˫ϲv[0..k) ÿ s İɣϲ
+static SIMD_TARGET void SIMD_FN(_MergeStage)(VEC* v, int k, int s) {
+    // ת
+    if (s <= SIMD_W) {
+        int layer = 0;
+        while ((2 << layer) < s) layer++;
+        for (int r = 0; r < k; r++) v[r] = SIMD_FN(_Layer)(v[r], layer);
+    }
+    else {
+        int rs = s / SIMD_W;
+        for (int r = 0; r < k; r++) {
+            int r2 = r ^ (rs - 1);
+            if (r2 < r) continue;
+            VEC p = VPERM(v[r2], SIMD_FN(g_rev));
+            VEC hi = VMAX(v[r], p);
+            v[r] = VMIN(v[r], p);
+            v[r2] = VPERM(hi, SIMD_FN(g_rev));
+        }
+    }
+    // 
+    for (int d = s >> 2; d > 0; d >>= 1) {
+        if (d >= SIMD_W) {
+            int rd = d / SIMD_W;
+            for (int r = 0; r < k; r++) {
+                int r2 = r ^ rd;
+                if (r2 < r) continue;
+                VEC lo = VMIN(v[r], v[r2]);
+                v[r2] = VMAX(v[r], v[r2]);
+                v[r] = lo;
+            }
+        }
+        else {
+            int layer = SIMD_LOG;
+            while ((1 << (layer - SIMD_LOG)) < d) layer++;
+            for (int r = 0; r < k; r++) v[r] = SIMD_FN(_Layer)(v[r], layer);
+        }
+    }
+}
+
+//  a[0..n)n Ϊ SIMD_W  2 ݱҲ SIMD_NET_MAX
+// ڼĴźã𼶰ڵ˫ϲ
+static SIMD_TARGET void SIMD_FN(_Sort)(int* a, int n) {
+    VEC v[SIMD_NET_MAX / SIMD_W];
+    int k = n / SIMD_W;
+    for (int r = 0; r < k; r++) v[r] = VLOAD(a + r * SIMD_W);
+    for (int s = 2; s <= n; s <<= 1) SIMD_FN(_MergeStage)(v, k, s);
+    for (int r = 0; r < k; r++) VSTORE(a + r * SIMD_W, v[r]);
+}
@@ -0,0 +1,430 @@
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif
+
+#include "sort_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+// ̶̳߳أ̰߳贴פв㷨á
+// "ҵ"ΪλŶӣ߳ԼҲȡ±ִУ
+// ˼ʹ̶߳æҵҲɣ
+
+// 0. ƽ̨װ
+#ifdef _WIN32
+typedef SRWLOCK PoolMutex;
+typedef CONDITION_VARIABLE PoolCond;
+#define POOL_MUTEX_INIT SRWLOCK_INIT
+#define POOL_COND_INIT CONDITION_VARIABLE_INIT
+#define mutex_init(m) InitializeSRWLock(m)
+#define mutex_destroy(m) ((void)0)
+#define mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define cond_init(c) InitializeConditionVariable(c)
+#define cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define cond_broadcast(c) WakeAllConditionVariable(c)
+#define cond_destroy(c) ((void)0)
+#else
+typedef pthread_mutex_t PoolMutex;
+typedef pthread_cond_t PoolCond;
+#define POOL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define POOL_COND_INIT PTHREAD_COND_INITIALIZER
+#define mutex_init(m) pthread_mutex_init(m, NULL)
+#define mutex_destroy(m) pthread_mutex_destroy(m)
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#define cond_init(c) pthread_cond_init(c, NULL)
+#define cond_wait(c, m) pthread_cond_wait(c, m)
+#define cond_broadcast(c) pthread_cond_broadcast(c)
+#define cond_destroy(c) pthread_cond_destroy(c)
+#endif
+
+// ԭȡһ±
+static int atomic_next(volatile long* p) {
+#ifdef _WIN32
+    return (int)InterlockedIncrement(p) - 1;
+#else
+    return (int)__atomic_fetch_add(p, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static void atomic_add(volatile long* p, long v) {
+#ifdef _WIN32
+    InterlockedExchangeAdd(p, v);
+#else
+    __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long atomic_load(volatile long* p) {
+#ifdef _WIN32
+    return *p;
+#else
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void thread_yield(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+// 1. ҵ
+typedef struct ParallelJob {
+    void (*func)(void* arg, int index);
+    void* arg;
+    int count;
+    volatile long next;          // һȡ±
+    int queued;                  // ڶСδߵ
+    int running;                 // ִеĹ߳
+    long long cmp;               // ߳ۼƵıȽϴ
+    long long moves;             // ߳ۼƵƶ
+    PoolCond done;
+    struct ParallelJob* nextJob; // 
+} ParallelJob;
+
+static PoolMutex g_poolLock = POOL_MUTEX_INIT;
+static PoolCond g_poolCond = POOL_COND_INIT;
+static ParallelJob* g_queueHead = NULL;
+static ParallelJob* g_queueTail = NULL;
+static int g_workerCount = 0;
+
+static void run_indices(ParallelJob* job) {
+    int i;
+    while ((i = atomic_next(&job->next)) < job->count) {
+        job->func(job->arg, i);
+    }
+}
+
+// Ӷժҵ ()
+static void unlink_job(ParallelJob* job) {
+    ParallelJob* prev = NULL;
+    for (ParallelJob* p = g_queueHead; p; prev = p, p = p->nextJob) {
+        if (p != job) continue;
+        if (prev) prev->nextJob = p->nextJob;
+        else g_queueHead = p->nextJob;
+        if (g_queueTail == p) g_queueTail = prev;
+        break;
+    }
+    job->nextJob = NULL;
+}
+
+static void worker_loop(void) {
+    mutex_lock(&g_poolLock);
+    for (;;) {
+        while (!g_queueHead) cond_wait(&g_poolCond, &g_poolLock);
+
+        ParallelJob* job = g_queueHead;
+        if (--job->queued == 0) unlink_job(job);
+        job->running++;
+        mutex_unlock(&g_poolLock);
+
+        run_indices(job);
+        long long cmp, moves;
+        stats_take(&cmp, &moves);
+
+        mutex_lock(&g_poolLock);
+        job->cmp += cmp;
+        job->moves += moves;
+        if (--job->running == 0) cond_broadcast(&job->done);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID unused) {
+    (void)unused;
+    worker_loop();
+    return 0;
+}
+#else
+static void* worker_main(void* unused) {
+    (void)unused;
+    worker_loop();
+    return NULL;
+}
+#endif
+
+// ֤ count ߳ ()
+// ̵߳ CPU ϣLinux ̼̳߳дߵİ󶨣߳Ѱ󶨵 CPU
+// (׼Ե -c)贴Ĺ̻߳ȫ CPU ϡ
+// ڼʱ½̵ CPU ϣ߳ʱʽʹ
+// Windows ̼̳߳еǽ̵׺ԶǴ̵߳ģ账
+#ifndef _WIN32
+static cpu_set_t g_startCpus;
+static int g_hasStartCpus = 0;
+
+__attribute__((constructor)) static void capture_start_cpus(void) {
+    g_hasStartCpus = sched_getaffinity(0, sizeof(g_startCpus), &g_startCpus) == 0;
+}
+#endif
+
+static void ensure_workers(int count) {
+    if (count > POOL_MAX_THREADS - 1) count = POOL_MAX_THREADS - 1;
+    while (g_workerCount < count) {
+#ifdef _WIN32
+        HANDLE h = CreateThread(NULL, 0, worker_main, NULL, 0, NULL);
+        if (!h) break;
+        CloseHandle(h);
+#else
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (g_hasStartCpus) pthread_attr_setaffinity_np(&attr, sizeof(g_startCpus), &g_startCpus);
+        pthread_t t;
+        int rc = pthread_create(&t, &attr, worker_main, NULL);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) break;
+        pthread_detach(t);
+#endif
+        g_workerCount++;
+    }
+}
+
+// 2. ӿ
+int pool_hardware_threads(void) {
+    static int cached = 0;
+    if (cached == 0) {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        int n = (int)info.dwNumberOfProcessors;
+#else
+        int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        cached = n > 0 ? n : 1;
+    }
+    return cached;
+}
+
+void pool_parallel_for(int count, int threads, void (*func)(void* arg, int index), void* arg) {
+    if (count <= 0) return;
+    if (threads > count) threads = count;
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++) func(arg, i);
+        return;
+    }
+
+    ParallelJob job;
+    job.func = func;
+    job.arg = arg;
+    job.count = count;
+    job.next = 0;
+    job.queued = threads - 1;
+    job.running = 0;
+    job.cmp = 0;
+    job.moves = 0;
+    job.nextJob = NULL;
+    cond_init(&job.done);
+
+    mutex_lock(&g_poolLock);
+    ensure_workers(threads - 1);
+    if (g_queueTail) g_queueTail->nextJob = &job;
+    else g_queueHead = &job;
+    g_queueTail = &job;
+    cond_broadcast(&g_poolCond);
+    mutex_unlock(&g_poolLock);
+
+    run_indices(&job);
+
+    // ûߵٵѿʼĹ߳̽
+    mutex_lock(&g_poolLock);
+    if (job.queued > 0) {
+        unlink_job(&job);
+        job.queued = 0;
+    }
+    while (job.running > 0) cond_wait(&job.done, &g_poolLock);
+    mutex_unlock(&g_poolLock);
+
+    cond_destroy(&job.done);
+    stats_add(job.cmp, job.moves);
+}
+
+// 첽ͬһҵṹֻһ±̲꣬߳
+int pool_submit(PoolTask* task, void (*func)(void* arg, int index), void* arg) {
+    ParallelJob* job = (ParallelJob*)malloc(sizeof(ParallelJob));
+    task->job = job;
+    if (!job) {
+        func(arg, 0);   // ڴ治ʱִͬУ
+        return -1;
+    }
+    job->func = func;
+    job->arg = arg;
+    job->count = 1;
+    job->next = 0;
+    job->queued = 1;
+    job->running = 0;
+    job->cmp = 0;
+    job->moves = 0;
+    job->nextJob = NULL;
+    cond_init(&job->done);
+
+    mutex_lock(&g_poolLock);
+    ensure_workers(1);
+    if (g_queueTail) g_queueTail->nextJob = job;
+    else g_queueHead = job;
+    g_queueTail = job;
+    cond_broadcast(&g_poolCond);
+    mutex_unlock(&g_poolLock);
+    return 0;
+}
+
+void pool_wait(PoolTask* task) {
+    ParallelJob* job = (ParallelJob*)task->job;
+    if (!job) return;
+    task->job = NULL;
+
+    // ûй߳ʱɵ߳Լִ
+    mutex_lock(&g_poolLock);
+    int runHere = job->queued > 0;
+    if (runHere) {
+        unlink_job(job);
+        job->queued = 0;
+    }
+    mutex_unlock(&g_poolLock);
+    if (runHere) run_indices(job);
+
+    mutex_lock(&g_poolLock);
+    while (job->running > 0) cond_wait(&job->done, &g_poolLock);
+    mutex_unlock(&g_poolLock);
+
+    cond_destroy(&job->done);
+    stats_add(job->cmp, job->moves);
+    free(job);
+}
+
+// 3. ȡ
+typedef struct {
+    WsWorker* workers;
+    int count;
+    volatile long pending;       // ӵδΪ 0 ʱȫ
+    void (*process)(void* arg, WsWorker* self, int low, int high);
+    void* arg;
+} WsRun;
+
+struct WsWorker {
+    PoolMutex lock;
+    WsRange* items;              // ЧԪΪ [head, tail)
+    int head;                    // ײȡˣŽĴ
+    int tail;                    // ߶
+    int capacity;
+    WsRun* run;
+};
+
+void ws_push(WsWorker* self, int low, int high) {
+    atomic_add(&self->run->pending, 1);
+    mutex_lock(&self->lock);
+    if (self->tail == self->capacity) {
+        if (self->head > 0) {
+            memmove(self->items, self->items + self->head, (size_t)(self->tail - self->head) * sizeof(WsRange));
+            self->tail -= self->head;
+            self->head = 0;
+        }
+        else {
+            int cap = self->capacity ? self->capacity * 2 : 64;
+            WsRange* p = (WsRange*)realloc(self->items, (size_t)cap * sizeof(WsRange));
+            if (!p) {
+                // ڴ治ʱ˻ΪֱӴ֤
+                mutex_unlock(&self->lock);
+                self->run->process(self->run->arg, self, low, high);
+                atomic_add(&self->run->pending, -1);
+                return;
+            }
+            self->items = p;
+            self->capacity = cap;
+        }
+    }
+    self->items[self->tail].low = low;
+    self->items[self->tail].high = high;
+    self->tail++;
+    mutex_unlock(&self->lock);
+}
+
+static int ws_pop(WsWorker* self, WsRange* out) {
+    int ok = 0;
+    mutex_lock(&self->lock);
+    if (self->tail > self->head) {
+        *out = self->items[--self->tail];
+        ok = 1;
+    }
+    mutex_unlock(&self->lock);
+    return ok;
+}
+
+static int ws_steal(WsRun* run, int id, unsigned* seed, WsRange* out) {
+    *seed = *seed * 1103515245u + 12345u;
+    int start = (int)((*seed >> 16) % (unsigned)run->count);
+    for (int k = 0; k < run->count; k++) {
+        int v = (start + k) % run->count;
+        if (v == id) continue;
+        WsWorker* victim = &run->workers[v];
+        int ok = 0;
+        mutex_lock(&victim->lock);
+        if (victim->tail > victim->head) {
+            *out = victim->items[victim->head++];
+            ok = 1;
+        }
+        mutex_unlock(&victim->lock);
+        if (ok) return 1;
+    }
+    return 0;
+}
+
+static void ws_worker_main(void* arg, int id) {
+    WsRun* run = (WsRun*)arg;
+    WsWorker* self = &run->workers[id];
+    unsigned seed = (unsigned)id * 2654435761u + 1u;
+    WsRange r;
+    for (;;) {
+        if (ws_pop(self, &r) || ws_steal(run, id, &seed, &r)) {
+            run->process(run->arg, self, r.low, r.high);
+            atomic_add(&run->pending, -1);
+        }
+        else if (atomic_load(&run->pending) == 0) {
+            break;
+        }
+        else {
+            thread_yield();
+        }
+    }
+}
+
+void pool_work_stealing(int threads, const WsRange roots[], int rootCount,
+    void (*process)(void* arg, WsWorker* self, int low, int high), void* arg) {
+    if (threads < 1) threads = 1;
+    WsWorker single;
+    WsRun run;
+    run.workers = (WsWorker*)calloc((size_t)threads, sizeof(WsWorker));
+    if (!run.workers) {
+        // ʧʱ˻Ϊ߳
+        memset(&single, 0, sizeof(single));
+        run.workers = &single;
+        threads = 1;
+    }
+    run.count = threads;
+    run.pending = 0;
+    run.process = process;
+    run.arg = arg;
+
+    for (int i = 0; i < threads; i++) {
+        mutex_init(&run.workers[i].lock);
+        run.workers[i].run = &run;
+    }
+    for (int i = 0; i < rootCount; i++) ws_push(&run.workers[0], roots[i].low, roots[i].high);
+
+    pool_parallel_for(threads, threads, ws_worker_main, &run);
+
+    for (int i = 0; i < threads; i++) {
+        mutex_destroy(&run.workers[i].lock);
+        free(run.workers[i].items);
+    }
+    if (run.workers != &single) free(run.workers);
+}
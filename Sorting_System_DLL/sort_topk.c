@@ -0,0 +1,165 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define TOPK_SSE2 1
+#include <emmintrin.h>
+#else
+#define TOPK_SSE2 0
+#endif
+
+// ʽ top-kݷֿ鵽ֻ k Ԫصнѡ
+// Ѱ""֯ɴ󶥶ѣѶǵǰżȡС k ʱΪԭֵȡ k ʱΪ ~v (ȡ)
+// Ԫعż SIMD ÿαȽ 16 Ԫأ鶼żֱ
+
+#define TOPK_BLOCK 16
+
+struct TopKStream {
+    int k;
+    int largest;
+    int count;               // Ԫ
+    int* heap;
+    long long seen;          // ۼԪ
+    long long comparisons;
+    long long moves;
+    double ms;               // push/result ۼƺʱ
+};
+
+static int topk_key(const TopKStream* s, int v) {
+    return s->largest ? ~v : v;
+}
+
+// 1. Ѳ
+static void sift_up(TopKStream* s, int i) {
+    int* h = s->heap;
+    int v = h[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        s->comparisons++;
+        if (h[parent] >= v) break;
+        h[i] = h[parent];
+        s->moves++;
+        i = parent;
+    }
+    h[i] = v;
+    s->moves++;
+}
+
+static void sift_down(int* h, int n, int i, long long* cmp, long long* moves) {
+    int v = h[i];
+    int child = 2 * i + 1;
+    while (child < n) {
+        if (child + 1 < n) {
+            (*cmp)++;
+            if (h[child] < h[child + 1]) child++;
+        }
+        (*cmp)++;
+        if (h[child] <= v) break;
+        h[i] = h[child];
+        (*moves)++;
+        i = child;
+        child = 2 * i + 1;
+    }
+    h[i] = v;
+    (*moves)++;
+}
+
+// ĵԪأСڶѶ滻
+static void offer(TopKStream* s, int v) {
+    int key = topk_key(s, v);
+    s->comparisons++;
+    if (key < s->heap[0]) {
+        s->heap[0] = key;
+        sift_down(s->heap, s->k, 0, &s->comparisons, &s->moves);
+    }
+}
+
+// 2. ӿ
+EXPORT TopKStream* topk_create(int k, int largest) {
+    if (k <= 0) return NULL;
+    TopKStream* s = (TopKStream*)calloc(1, sizeof(TopKStream));
+    if (!s) return NULL;
+    s->heap = (int*)malloc((size_t)k * sizeof(int));
+    if (!s->heap) {
+        free(s);
+        return NULL;
+    }
+    s->k = k;
+    s->largest = largest != 0;
+    return s;
+}
+
+EXPORT void topk_destroy(TopKStream* s) {
+    if (!s) return;
+    free(s->heap);
+    free(s);
+}
+
+EXPORT int topk_push(TopKStream* s, const int* chunk, int n) {
+    if (!s || n < 0 || (!chunk && n > 0)) return -1;
+    double start = get_time_ms();
+    int i = 0;
+    // δʱֱ
+    while (s->count < s->k && i < n) {
+        s->heap[s->count] = topk_key(s, chunk[i++]);
+        sift_up(s, s->count++);
+    }
+    if (s->count == s->k) {
+#if TOPK_SSE2
+        for (; i + TOPK_BLOCK <= n; i += TOPK_BLOCK) {
+            // żԭֵռȽϣС k Ҫ v < ż k Ҫ v > ~ż
+            __m128i t = _mm_set1_epi32(s->largest ? ~s->heap[0] : s->heap[0]);
+            const __m128i* p = (const __m128i*)(chunk + i);
+            __m128i a = _mm_loadu_si128(p), b = _mm_loadu_si128(p + 1);
+            __m128i c = _mm_loadu_si128(p + 2), d = _mm_loadu_si128(p + 3);
+            __m128i hit;
+            if (s->largest) {
+                hit = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(a, t), _mm_cmpgt_epi32(b, t)),
+                                   _mm_or_si128(_mm_cmpgt_epi32(c, t), _mm_cmpgt_epi32(d, t)));
+            }
+            else {
+                hit = _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(a, t), _mm_cmplt_epi32(b, t)),
+                                   _mm_or_si128(_mm_cmplt_epi32(c, t), _mm_cmplt_epi32(d, t)));
+            }
+            s->comparisons += TOPK_BLOCK;
+            if (_mm_movemask_epi8(hit) == 0) continue;
+            for (int j = 0; j < TOPK_BLOCK; j++) offer(s, chunk[i + j]);
+        }
+#endif
+        for (; i < n; i++) offer(s, chunk[i]);
+    }
+    s->seen += n;
+    s->ms += get_time_ms() - start;
+    return 0;
+}
+
+// ѵǰд out (С k Ϊ k Ϊ)ظ֮Կɼ push
+EXPORT int topk_result(TopKStream* s, int* out, SortPerformance* stats) {
+    if (!s || (!out && s->count > 0)) return -1;
+    double start = get_time_ms();
+    int n = s->count;
+    if (n > 0) memcpy(out, s->heap, (size_t)n * sizeof(int));
+    s->moves += n;
+    // Ǵ󶥶ѣԭض򼴵
+    for (int i = n - 1; i > 0; i--) {
+        int t = out[0];
+        out[0] = out[i];
+        out[i] = t;
+        s->moves += 3;
+        sift_down(out, i, 0, &s->comparisons, &s->moves);
+    }
+    for (int i = 0; i < n; i++) out[i] = topk_key(s, out[i]);
+    s->ms += get_time_ms() - start;
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        snprintf(stats->algorithm, sizeof(stats->algorithm), "Stream Top-K (%s)", s->largest ? "max" : "min");
+        stats->dataSize = s->seen > 0x7fffffff ? 0x7fffffff : (int)s->seen;
+        stats->compareCount = s->comparisons;
+        stats->moveCount = s->moves;
+        stats->timeCost = s->ms;
+    }
+    return n;
+}
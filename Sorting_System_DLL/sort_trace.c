@@ -0,0 +1,264 @@
+#include "sort_internal.h"
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ׷٣׷ٰںÿһαȽ//д͵ trace_emit 8 ֽڵ¼׷ӵ塣
+// ¼ʱάһݰ¼طŵӰ飬ÿ interval ¼һݹؼ֡
+// طŵ step ֡ʱȡؼ֡˳ִм¼
+// Ƚλ¼ı飬˿Գд֡
+
+#define TRACE_MIN_INTERVAL 65536     // Զؼ֡ (¼)
+#define TRACE_INTERVAL_RATIO 4       // ԶΪ n ĸñؼ֡Լռ¼ڴ 1/8
+#define TRACE_INIT_EVENTS 4096       // ڲĳʼ
+#define TRACE_MAX_INDEX 0x0fffffff   // ±ռ 28 λ
+
+struct SortTrace {
+    int n;
+    SortEvent* events;
+    long long cap;               // events  (ڲΪǰѷĴС)
+    long long limit;             // ¼ޣ0 Ϊ (ڲ)
+    int owned;                   // events ǷΪڲ
+    int ring;
+    int truncated;
+    int sample;
+    long long sampleCount;
+    long long total;             // Ѽ¼¼
+    long long interval;
+
+    const int* base;             // ¼е
+    int* shadow;                 // ¼ʱ¼طŵ飬ؼ֡︴
+    long long* markStep;         // λ״ιλ֡ţδλΪ LLONG_MAX
+
+    int* keys;                   // keyCount ݹؼ֡ÿ n Ԫ
+    long long* keySteps;
+    int keyCount;
+    int keyCap;
+
+    int* cursor;                 // һλطŵ֡ţ˳򲥷ʱ
+    long long cursorStep;
+};
+
+static SORT_TLS SortTrace* t_rec = NULL;   // ǰ߳¼Ƶ׷
+
+// 1. ¼
+EXPORT void sort_trace_options_init(SortTraceOptions* opt) {
+    memset(opt, 0, sizeof(SortTraceOptions));
+}
+
+static void apply_event(int* a, SortEvent e) {
+    int i = SORT_EV_INDEX(e);
+    switch (SORT_EV_TYPE(e)) {
+    case SORT_EV_SWAP: {
+        int t = a[i];
+        a[i] = a[e.arg];
+        a[e.arg] = t;
+        break;
+    }
+    case SORT_EV_WRITE:
+        a[i] = e.arg;
+        break;
+    default:
+        break;
+    }
+}
+
+static SortEvent* event_at(const SortTrace* t, long long index) {
+    return t->events + (t->ring ? index % t->cap : index);
+}
+
+// λѱǵĹؼ֡޷ڻط
+static long long oldest_event(const SortTrace* t) {
+    return t->ring && t->total > t->cap ? t->total - t->cap : 0;
+}
+
+static void prune_keyframes(SortTrace* t) {
+    long long oldest = oldest_event(t);
+    int drop = 0;
+    while (drop < t->keyCount && t->keySteps[drop] < oldest) drop++;
+    if (drop > 0) {
+        t->keyCount -= drop;
+        memmove(t->keys, t->keys + (size_t)drop * t->n, (size_t)t->keyCount * t->n * sizeof(int));
+        memmove(t->keySteps, t->keySteps + drop, (size_t)t->keyCount * sizeof(long long));
+    }
+}
+
+static int add_keyframe(SortTrace* t) {
+    prune_keyframes(t);
+    if (t->keyCount == t->keyCap) {
+        int cap = t->keyCap ? t->keyCap * 2 : 8;
+        int* keys = (int*)realloc(t->keys, (size_t)cap * (t->n > 0 ? t->n : 1) * sizeof(int));
+        if (!keys) return -1;
+        t->keys = keys;
+        long long* steps = (long long*)realloc(t->keySteps, (size_t)cap * sizeof(long long));
+        if (!steps) return -1;
+        t->keySteps = steps;
+        t->keyCap = cap;
+    }
+    memcpy(t->keys + (size_t)t->keyCount * t->n, t->shadow, (size_t)t->n * sizeof(int));
+    t->keySteps[t->keyCount++] = t->total;
+    return 0;
+}
+
+// Ϊһ¼ڳλã 0 ʾټ¼
+static int reserve_event(SortTrace* t) {
+    if (t->total < t->cap || t->ring) return 1;
+    if (t->owned && (t->limit == 0 || t->cap < t->limit)) {
+        long long cap = t->cap * 2;
+        if (t->limit > 0 && cap > t->limit) cap = t->limit;
+        SortEvent* events = (SortEvent*)realloc(t->events, (size_t)cap * sizeof(SortEvent));
+        if (events) {
+            t->events = events;
+            t->cap = cap;
+            return 1;
+        }
+    }
+    t->truncated = 1;
+    return 0;
+}
+
+void trace_emit(int type, const int* p, const int* q) {
+    SortTrace* t = t_rec;
+    if (!t || t->truncated) return;
+    ptrdiff_t i = p - t->base;
+    if (i < 0 || i >= t->n) return;
+    int arg = 0;
+    if (q) {
+        ptrdiff_t j = q - t->base;
+        if (j < 0 || j >= t->n) return;
+        arg = (int)j;
+    }
+    if (type == SORT_EV_COMPARE && t->sample > 1 && t->sampleCount++ % t->sample != 0) return;
+    if (type == SORT_EV_WRITE) arg = *p;
+    if (!reserve_event(t)) return;
+
+    SortEvent e;
+    e.head = ((unsigned int)type << 28) | (unsigned int)i;
+    e.arg = arg;
+    *event_at(t, t->total) = e;
+    apply_event(t->shadow, e);
+    t->total++;
+    if (type == SORT_EV_PHASE && t->markStep[i] == LLONG_MAX) t->markStep[i] = t->total;
+    if (t->total % t->interval == 0 && add_keyframe(t) != 0) t->truncated = 1;
+}
+
+EXPORT void sort_trace_free(SortTrace* t) {
+    if (!t) return;
+    if (t->owned) free(t->events);
+    free(t->shadow);
+    free(t->markStep);
+    free(t->keys);
+    free(t->keySteps);
+    free(t->cursor);
+    free(t);
+}
+
+EXPORT SortTrace* sort_trace_run(int algo, int* arr, int n, const SortTraceOptions* opt, SortPerformance* stats) {
+    SortTraceOptions def;
+    if (!opt) {
+        sort_trace_options_init(&def);
+        opt = &def;
+    }
+    if ((!arr && n > 0) || n < 0 || n > TRACE_MAX_INDEX || opt->capacity < 0) return NULL;
+    if (opt->buffer && opt->capacity <= 0) return NULL;
+    if (opt->ring && opt->capacity < 2) return NULL;
+
+    SortTrace* t = (SortTrace*)calloc(1, sizeof(SortTrace));
+    if (!t) return NULL;
+    size_t bytes = (size_t)(n > 0 ? n : 1) * sizeof(int);
+    t->n = n;
+    t->ring = opt->ring;
+    t->sample = opt->compareSample;
+    t->limit = opt->capacity;
+    t->interval = opt->keyframeInterval;
+    if (t->interval <= 0) {
+        t->interval = (long long)n * TRACE_INTERVAL_RATIO;
+        if (t->interval < TRACE_MIN_INTERVAL) t->interval = TRACE_MIN_INTERVAL;
+    }
+    if (opt->buffer) {
+        t->events = opt->buffer;
+        t->cap = opt->capacity;
+    }
+    else {
+        // λһη䵽λС
+        t->cap = t->ring || (t->limit > 0 && t->limit < TRACE_INIT_EVENTS) ? t->limit : TRACE_INIT_EVENTS;
+        t->events = (SortEvent*)malloc((size_t)t->cap * sizeof(SortEvent));
+        t->owned = 1;
+    }
+    // λҪסһݹؼ֮֡ȫ¼
+    if (t->ring && t->interval > t->cap / 2) t->interval = t->cap / 2;
+    t->shadow = (int*)malloc(bytes);
+    t->cursor = (int*)malloc(bytes);
+    t->markStep = (long long*)malloc((size_t)(n > 0 ? n : 1) * sizeof(long long));
+    if (!t->events || !t->shadow || !t->cursor || !t->markStep) {
+        sort_trace_free(t);
+        return NULL;
+    }
+    memcpy(t->shadow, arr, (size_t)n * sizeof(int));
+    for (int i = 0; i < n; i++) t->markStep[i] = LLONG_MAX;
+    t->cursorStep = -1;
+    if (add_keyframe(t) != 0) {
+        sort_trace_free(t);
+        return NULL;
+    }
+
+    t->base = arr;
+    t_rec = t;
+    int ret = sort_run_traced(algo, arr, n, stats);
+    t_rec = NULL;
+    t->base = NULL;
+    if (ret != 0) {
+        sort_trace_free(t);
+        return NULL;
+    }
+    // ĩ֡ҲΪؼ֡βط (ǰֹͣʱӰͣһ¼ͬ)
+    if (t->keyCount == 0 || t->keySteps[t->keyCount - 1] != t->total) add_keyframe(t);
+    prune_keyframes(t);
+    return t;
+}
+
+// 2. ط
+EXPORT long long sort_trace_length(const SortTrace* t) {
+    return t ? t->total : 0;
+}
+
+EXPORT long long sort_trace_first(const SortTrace* t) {
+    return t && t->keyCount > 0 ? t->keySteps[0] : 0;
+}
+
+EXPORT int sort_trace_truncated(const SortTrace* t) {
+    return t ? t->truncated : 0;
+}
+
+EXPORT int sort_trace_event(const SortTrace* t, long long index, SortEvent* out) {
+    if (!t || !out || index < oldest_event(t) || index >= t->total) return -1;
+    *out = *event_at(t, index);
+    return 0;
+}
+
+EXPORT int sort_trace_frame(SortTrace* t, long long step, int* out, unsigned char* marks) {
+    if (!t || (!out && t->n > 0) || t->keyCount == 0 || step < t->keySteps[0] || step > t->total) return -1;
+    //  step ؼ֡
+    int lo = 0, hi = t->keyCount - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (t->keySteps[mid] <= step) lo = mid;
+        else hi = mid - 1;
+    }
+    long long from = t->keySteps[lo];
+    if (t->cursorStep >= from && t->cursorStep <= step) {
+        from = t->cursorStep;
+    }
+    else {
+        memcpy(t->cursor, t->keys + (size_t)lo * t->n, (size_t)t->n * sizeof(int));
+    }
+    for (long long s = from; s < step; s++) apply_event(t->cursor, *event_at(t, s));
+    t->cursorStep = step;
+
+    memcpy(out, t->cursor, (size_t)t->n * sizeof(int));
+    if (marks) {
+        for (int i = 0; i < t->n; i++) marks[i] = t->markStep[i] <= step;
+    }
+    return 0;
+}
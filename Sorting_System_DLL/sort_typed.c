@@ -0,0 +1,137 @@
+#include "sort_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// sort_kernels_pdq.h ԪͷֱʵȽֱ·ûкָ롣
+// ʹȫNaN ఴֵ (-0.0  0.0 Ϊ)
+
+static SORT_TLS long long t_comparisons = 0;
+static SORT_TLS long long t_moves = 0;
+
+#define PLAIN_LESS(a, b) ((a) < (b))
+#define FLOAT_LESS(a, b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+#define SELF_KEY(x) (x)
+
+// 1. ʵ
+#define TYPED_NAME(name) name##I32
+#define TYPED_T int
+#define TYPED_KEY_T int
+#define TYPED_KEY(x) SELF_KEY(x)
+#define TYPED_KEY_LESS(a, b) PLAIN_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+#define TYPED_NAME(name) name##I64
+#define TYPED_T long long
+#define TYPED_KEY_T long long
+#define TYPED_KEY(x) SELF_KEY(x)
+#define TYPED_KEY_LESS(a, b) PLAIN_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+#define TYPED_NAME(name) name##U64
+#define TYPED_T unsigned long long
+#define TYPED_KEY_T unsigned long long
+#define TYPED_KEY(x) SELF_KEY(x)
+#define TYPED_KEY_LESS(a, b) PLAIN_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+#define TYPED_NAME(name) name##F32
+#define TYPED_T float
+#define TYPED_KEY_T float
+#define TYPED_KEY(x) SELF_KEY(x)
+#define TYPED_KEY_LESS(a, b) FLOAT_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+#define TYPED_NAME(name) name##F64
+#define TYPED_T double
+#define TYPED_KEY_T double
+#define TYPED_KEY(x) SELF_KEY(x)
+#define TYPED_KEY_LESS(a, b) FLOAT_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+// ֵ¼ key value  key һƶ
+#define TYPED_NAME(name) name##KV64
+#define TYPED_T SortKV64
+#define TYPED_KEY_T long long
+#define TYPED_KEY(x) ((x).key)
+#define TYPED_KEY_LESS(a, b) PLAIN_LESS(a, b)
+#include "sort_typed_inst.h"
+#undef TYPED_NAME
+#undef TYPED_T
+#undef TYPED_KEY_T
+#undef TYPED_KEY
+#undef TYPED_KEY_LESS
+
+// 2. ͱ± SortElemType һ
+typedef struct {
+    const char* name;
+    void (*sort)(void* data, int n, int fast);
+    int (*argsort)(const void* data, int n, int* index, int fast);
+} TypedOps;
+
+static const TypedOps g_typedOps[SORT_TYPE_COUNT] = {
+    { "i32",  typed_sortI32,  typed_argsortI32 },
+    { "i64",  typed_sortI64,  typed_argsortI64 },
+    { "u64",  typed_sortU64,  typed_argsortU64 },
+    { "f32",  typed_sortF32,  typed_argsortF32 },
+    { "f64",  typed_sortF64,  typed_argsortF64 },
+    { "kv64", typed_sortKV64, typed_argsortKV64 },
+};
+
+static void typed_stats(SortPerformance* stats, const char* algo, int type, int n, int fast, double ms) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    snprintf(stats->algorithm, sizeof(stats->algorithm), "%s (%s%s)", algo, g_typedOps[type].name, fast ? ", Fast" : "");
+    stats->dataSize = n;
+    stats->compareCount = t_comparisons;
+    stats->moveCount = t_moves;
+    stats->timeCost = ms;
+}
+
+// 3. ӿ
+EXPORT int sort_typed(void* data, int n, int type, int options, SortPerformance* stats) {
+    if (n < 0 || (!data && n > 0) || type < 0 || type >= SORT_TYPE_COUNT) return -1;
+    int fast = (options & SORT_OPT_FAST) != 0;
+    t_comparisons = 0;
+    t_moves = 0;
+    double start = get_time_ms();
+    g_typedOps[type].sort(data, n, fast);
+    typed_stats(stats, "Pdq Sort", type, n, fast, get_time_ms() - start);
+    return 0;
+}
+
+EXPORT int argsort_typed(const void* data, int n, int type, int options, int* index, SortPerformance* stats) {
+    if (n < 0 || ((!data || !index) && n > 0) || type < 0 || type >= SORT_TYPE_COUNT) return -1;
+    int fast = (options & SORT_OPT_FAST) != 0;
+    t_comparisons = 0;
+    t_moves = 0;
+    double start = get_time_ms();
+    if (g_typedOps[type].argsort(data, n, index, fast) != 0) return -1;
+    typed_stats(stats, "Argsort", type, n, fast, get_time_ms() - start);
+    return 0;
+}
@@ -0,0 +1,81 @@
+// ĵʵ (sort_typed.c ΪÿԪͰһΣļû include guard)
+// ǰ趨壺
+//   TYPED_NAME(name)        Σ name##I64
+//   TYPED_T                 Ԫ
+//   TYPED_KEY_T             
+//   TYPED_KEY(x)            Ԫȡ
+//   TYPED_KEY_LESS(a, b)    ϸ
+// ɣԪر pdqsort (/㿪)  argsort õ (, ±) ¼
+
+// 1. Ԫ
+#define SORT_T TYPED_T
+#define SORT_LESS(a, b) TYPED_KEY_LESS(TYPED_KEY(a), TYPED_KEY(b))
+
+#define SORT_FN(name) TYPED_NAME(name)
+#define COUNT_CMP() (t_comparisons++)
+#define COUNT_MOVE(k) (t_moves += (k))
+#include "sort_kernels_pdq.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+
+#define SORT_FN(name) TYPED_NAME(name##Fast)
+#define COUNT_CMP() ((void)0)
+#define COUNT_MOVE(k) ((void)0)
+#include "sort_kernels_pdq.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+
+#undef SORT_T
+#undef SORT_LESS
+
+// 2. argsort (, ԭ±) ų¼򣬱Ȱ±ӷʼĻΪõöࣻ
+// ʱ±ţȶһ
+typedef struct {
+    TYPED_KEY_T key;
+    int idx;
+} TYPED_NAME(ArgRec);
+
+#define SORT_T TYPED_NAME(ArgRec)
+#define SORT_LESS(a, b) (TYPED_KEY_LESS((a).key, (b).key) || (!TYPED_KEY_LESS((b).key, (a).key) && (a).idx < (b).idx))
+
+#define SORT_FN(name) TYPED_NAME(name##Arg)
+#define COUNT_CMP() (t_comparisons++)
+#define COUNT_MOVE(k) (t_moves += (k))
+#include "sort_kernels_pdq.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+
+#define SORT_FN(name) TYPED_NAME(name##ArgFast)
+#define COUNT_CMP() ((void)0)
+#define COUNT_MOVE(k) ((void)0)
+#include "sort_kernels_pdq.h"
+#undef SORT_FN
+#undef COUNT_CMP
+#undef COUNT_MOVE
+
+#undef SORT_T
+#undef SORT_LESS
+
+// 3. 
+static void TYPED_NAME(typed_sort)(void* data, int n, int fast) {
+    if (fast) TYPED_NAME(_PdqSortFast)((TYPED_T*)data, n);
+    else TYPED_NAME(_PdqSort)((TYPED_T*)data, n);
+}
+
+static int TYPED_NAME(typed_argsort)(const void* data, int n, int* index, int fast) {
+    const TYPED_T* a = (const TYPED_T*)data;
+    TYPED_NAME(ArgRec)* rec = (TYPED_NAME(ArgRec)*)malloc((size_t)n * sizeof(TYPED_NAME(ArgRec)) + 1);
+    if (!rec) return -1;
+    for (int i = 0; i < n; i++) {
+        rec[i].key = TYPED_KEY(a[i]);
+        rec[i].idx = i;
+    }
+    if (fast) TYPED_NAME(_PdqSortArgFast)(rec, n);
+    else TYPED_NAME(_PdqSortArg)(rec, n);
+    for (int i = 0; i < n; i++) index[i] = rec[i].idx;
+    free(rec);
+    return 0;
+}
@@ -1,10 +1,14 @@
 import tkinter as tk
 from tkinter import ttk, messagebox, simpledialog, filedialog
+import array
 import ctypes
 import os
 import random
+import re
+import struct
 import csv
 import datetime
+from concurrent.futures import ThreadPoolExecutor
 
 # 0. 配置与常量
 COLORS_MAP = {
@@ -26,10 +30,32 @@ ALGO_INFO = {
                  "desc": "分治法，栈模拟递归分区"},
     "归并排序": {"time": "O(n log n)", "space": "O(n)", "stability": "稳定", "desc": "分治法(非递归)，自底向上合并"},
     "堆排序": {"time": "O(n log n)", "space": "O(1)", "stability": "不稳定",
-               "desc": "利用堆结构特性，不断移除堆顶最大值"}
+               "desc": "利用堆结构特性，不断移除堆顶最大值"},
+    "并行归并": {"time": "O(n log n / p)", "space": "O(n)", "stability": "稳定",
+                 "desc": "线程池并行自底向上归并，大段归并按 co-rank 切分"},
+    "并行快排": {"time": "O(n log n / p)", "space": "O(log n)", "stability": "不稳定",
+                 "desc": "顶层并行划分，之后各线程维护区间队列并相互窃取任务"},
+    "基数排序": {"time": "O(4n)", "space": "O(n)", "stability": "稳定",
+                 "desc": "LSD 按字节分桶，一次统计全部直方图，单桶的趟直接跳过"},
+    "模式快排": {"time": "O(n log n)", "space": "O(log n)", "stability": "不稳定",
+                 "desc": "pdqsort：九数取中、块划分，有序输入线性，失衡过多时转堆排序"},
+    "自适应归并": {"time": "O(n log n)", "space": "O(n)", "stability": "稳定",
+                   "desc": "TimSort：识别已有有序段，段栈平衡归并，连续胜出时成块复制"},
+    "乒乓归并": {"time": "O(n log n)", "space": "O(n)", "stability": "稳定",
+                 "desc": "两块缓冲交替作为源和目标，归并内层无分支，每趟只搬移一次"},
+    "四路归并": {"time": "O(n log n)", "space": "O(n)", "stability": "稳定",
+                 "desc": "乒乓归并的四路版，一趟合并四段，趟数减半"},
+    "计数排序": {"time": "O(n + k)", "space": "O(k)", "stability": "稳定",
+                 "desc": "按值计数后顺序写回；值域 k 超过元素数 8 倍时改用基数排序"},
+    "自适应": {"time": "视所选引擎", "space": "视所选引擎", "stability": "不保证",
+               "desc": "采样估计有序段、重复率与值域，按本机校准的阈值选择 TimSort/计数/基数/pdqsort"}
 }
 
 
+# 数据分布：下标与 C 端 SortDistribution 一致
+DIST_NAMES = ["随机", "正序", "逆序", "接近有序", "少量重复", "风琴管", "锯齿", "Zipf", "全范围"]
+
+
 # 1. C语言 DLL 接口
 class SortPerformance(ctypes.Structure):
     _pack_ = 1
@@ -38,48 +64,385 @@ class SortPerformance(ctypes.Structure):
         ("dataSize", ctypes.c_int),
         ("compareCount", ctypes.c_longlong),
         ("moveCount", ctypes.c_longlong),
-        ("timeCost", ctypes.c_double)
+        ("timeCost", ctypes.c_double),
+        ("passes", ctypes.c_int)
+    ]
+
+
+class SortContext(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [
+        ("stats", SortPerformance),
+        ("scratch", ctypes.POINTER(ctypes.c_int)),
+        ("scratchCapacity", ctypes.c_int),
+        ("options", ctypes.c_int),
+        ("threads", ctypes.c_int),
+        ("arena", ctypes.c_void_p)
+    ]
+
+
+class SortBuffer(ctypes.Structure):
+    _fields_ = [
+        ("ptr", ctypes.c_void_p),
+        ("length", ctypes.c_int),
+        ("stride", ctypes.c_longlong)  # 字节，0 表示紧密排列
+    ]
+
+
+SORT_OPT_NO_COPY = 0x2
+
+
+class SortEvent(ctypes.Structure):
+    _fields_ = [
+        ("head", ctypes.c_uint),  # 高 4 位类型，低 28 位下标 i
+        ("arg", ctypes.c_int)
+    ]
+
+
+class SortTraceOptions(ctypes.Structure):
+    _fields_ = [
+        ("buffer", ctypes.POINTER(SortEvent)),
+        ("capacity", ctypes.c_longlong),
+        ("ring", ctypes.c_int),
+        ("compareSample", ctypes.c_int),
+        ("keyframeInterval", ctypes.c_longlong)
     ]
 
 
+SORT_EV_COMPARE, SORT_EV_SWAP, SORT_EV_WRITE, SORT_EV_PHASE = 1, 2, 3, 4
+
+
 class C_Backend:
     def __init__(self):
         try:
             dll_path = os.path.join(os.path.dirname(__file__), "Sorting_System.dll")
             self.lib = ctypes.CDLL(dll_path)
-            for name in ["bubble_sort", "insertion_sort", "selection_sort",
-                         "shell_sort", "quick_sort", "merge_sort", "heap_sort"]:
+            names = ["bubble_sort", "insertion_sort", "selection_sort",
+                     "shell_sort", "quick_sort", "merge_sort", "heap_sort", "radix_sort", "pdq_sort", "tim_sort",
+                     "pingpong_merge_sort", "pingpong_merge_sort4", "counting_sort", "auto_sort"]
+            for name in names + [x + "_fast" for x in names]:  # 计数版 + 零开销版
                 if hasattr(self.lib, name):
                     func = getattr(self.lib, name)
                     func.restype = SortPerformance
                     func.argtypes = [ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+            for name in ["parallel_merge_sort", "parallel_merge_sort_fast",
+                         "parallel_quick_sort", "parallel_quick_sort_fast"]:  # 多一个线程数参数
+                if hasattr(self.lib, name):
+                    func = getattr(self.lib, name)
+                    func.restype = SortPerformance
+                    func.argtypes = [ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.c_int]
             if hasattr(self.lib, "generate_data_c"):
                 self.lib.generate_data_c.argtypes = [ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.c_int]
+            if hasattr(self.lib, "generate_data_ex"):
+                self.lib.generate_data_ex.restype = ctypes.c_int
+                self.lib.generate_data_ex.argtypes = [ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.c_int,
+                                                      ctypes.c_ulonglong, ctypes.c_int, ctypes.c_int]
+            if hasattr(self.lib, "load_text_file"):
+                int_pp = ctypes.POINTER(ctypes.POINTER(ctypes.c_int))
+                for name in ["load_text_file", "load_binary_file"]:
+                    getattr(self.lib, name).restype = ctypes.c_int
+                    getattr(self.lib, name).argtypes = [ctypes.c_char_p, ctypes.c_int, int_pp,
+                                                        ctypes.POINTER(ctypes.c_int)]
+                self.lib.unmap_binary_file.argtypes = [ctypes.POINTER(ctypes.c_int)]
+                self.lib.sort_free.argtypes = [ctypes.c_void_p]
+                self.lib.save_binary_file.restype = ctypes.c_int
+                self.lib.save_binary_file.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+            if hasattr(self.lib, "sort_buffer"):
+                self.lib.sort_buffer.restype = ctypes.c_int
+                self.lib.sort_buffer.argtypes = [ctypes.POINTER(SortContext), ctypes.c_int, ctypes.POINTER(SortBuffer),
+                                                 ctypes.c_void_p]
+            if hasattr(self.lib, "nth_element"):
+                int_p, perf_p = ctypes.POINTER(ctypes.c_int), ctypes.POINTER(SortPerformance)
+                for name in ["nth_element", "partial_sort"]:
+                    getattr(self.lib, name).restype = ctypes.c_int
+                    getattr(self.lib, name).argtypes = [int_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, perf_p]
+                self.lib.topk_create.restype = ctypes.c_void_p
+                self.lib.topk_create.argtypes = [ctypes.c_int, ctypes.c_int]
+                self.lib.topk_push.restype = ctypes.c_int
+                self.lib.topk_push.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_int]
+                self.lib.topk_result.restype = ctypes.c_int
+                self.lib.topk_result.argtypes = [ctypes.c_void_p, int_p, perf_p]
+                self.lib.topk_destroy.argtypes = [ctypes.c_void_p]
+            if hasattr(self.lib, "sort_tree_create"):
+                int_p, tree_p = ctypes.POINTER(ctypes.c_int), ctypes.c_void_p
+                signatures = {
+                    "sort_tree_create": (tree_p, []),
+                    "sort_tree_destroy": (None, [tree_p]),
+                    "sort_tree_size": (ctypes.c_longlong, [tree_p]),
+                    "sort_tree_insert": (ctypes.c_int, [tree_p, ctypes.c_int]),
+                    "sort_tree_insert_bulk": (ctypes.c_int, [tree_p, int_p, ctypes.c_int]),
+                    "sort_tree_erase": (ctypes.c_int, [tree_p, ctypes.c_int]),
+                    "sort_tree_rank": (ctypes.c_longlong, [tree_p, ctypes.c_int]),
+                    "sort_tree_select": (ctypes.c_int, [tree_p, ctypes.c_longlong, int_p]),
+                    "sort_tree_copy": (ctypes.c_int, [tree_p, ctypes.c_longlong, int_p, ctypes.c_int]),
+                    "sort_tree_range": (ctypes.c_int, [tree_p, ctypes.c_int, ctypes.c_int, int_p, ctypes.c_int]),
+                }
+                for name, (res, args) in signatures.items():
+                    getattr(self.lib, name).restype = res
+                    getattr(self.lib, name).argtypes = args
+            if hasattr(self.lib, "sort_batch"):
+                int_p = ctypes.POINTER(ctypes.c_int)
+                self.lib.sort_batch.restype = ctypes.c_int
+                self.lib.sort_batch.argtypes = [int_p, int_p, ctypes.c_int, ctypes.c_int, ctypes.c_int,
+                                                ctypes.POINTER(SortPerformance)]
+                self.lib.sort_batch_fixed.restype = ctypes.c_int
+                self.lib.sort_batch_fixed.argtypes = [int_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_int,
+                                                      ctypes.POINTER(SortPerformance)]
+            if hasattr(self.lib, "sort_trace_run"):
+                trace_p = ctypes.c_void_p
+                signatures = {
+                    "sort_trace_run": (trace_p, [ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.c_int,
+                                                 ctypes.POINTER(SortTraceOptions), ctypes.POINTER(SortPerformance)]),
+                    "sort_trace_free": (None, [trace_p]),
+                    "sort_trace_length": (ctypes.c_longlong, [trace_p]),
+                    "sort_trace_first": (ctypes.c_longlong, [trace_p]),
+                    "sort_trace_truncated": (ctypes.c_int, [trace_p]),
+                    "sort_trace_event": (ctypes.c_int, [trace_p, ctypes.c_longlong, ctypes.POINTER(SortEvent)]),
+                    "sort_trace_frame": (ctypes.c_int, [trace_p, ctypes.c_longlong, ctypes.POINTER(ctypes.c_int),
+                                                        ctypes.c_void_p]),
+                }
+                for name, (res, args) in signatures.items():
+                    getattr(self.lib, name).restype = res
+                    getattr(self.lib, name).argtypes = args
             self.available = True
         except Exception as e:
             print(f"Warning: DLL load failed ({e})")
             self.available = False
 
-    def generate_data(self, n, dtype):
-        if not self.available: return [random.randint(0, 1000) for _ in range(n)]
-        ArrayType = ctypes.c_int * n
-        c_arr = ArrayType()
-        self.lib.generate_data_c(c_arr, n, dtype)
-        return list(c_arr)
-
-    def run_sort(self, algo_name, data):
-        if not self.available: return None
-        mapping = {
-            "冒泡排序": "bubble_sort", "插入排序": "insertion_sort",
-            "选择排序": "selection_sort", "希尔排序": "shell_sort",
-            "快速排序": "quick_sort", "归并排序": "merge_sort", "堆排序": "heap_sort"
-        }
-        func = getattr(self.lib, mapping.get(algo_name))
+    @staticmethod
+    def _as_c(buf):
+        # array('i') 与 C 共享内存，不再逐元素拷贝
+        return (ctypes.c_int * len(buf)).from_buffer(buf)
+
+    @staticmethod
+    def _buffer_of(data):
+        """把 array('i') / numpy int32 / 其他 int32 缓冲包装成 SortBuffer，不复制；其余类型返回 None"""
+        ai = getattr(data, "__array_interface__", None)
+        if ai is not None:  # numpy：支持带步长的一维视图
+            if len(ai["shape"]) != 1 or ai["typestr"][1:] != "i4" or ai["typestr"][0] == ">": return None
+            if ai["data"][1]: return None  # 只读
+            stride = ai["strides"][0] if ai["strides"] else 4
+            return SortBuffer(ai["data"][0], ai["shape"][0], stride)
+        try:
+            view = memoryview(data)
+        except TypeError:
+            return None
+        if view.format != "i" or view.ndim != 1 or view.readonly or not view.c_contiguous: return None
+        if len(view) == 0: return SortBuffer(None, 0, 4)
+        return SortBuffer(ctypes.addressof(ctypes.c_char.from_buffer(view)), len(view), 4)
+
+    def generate_data(self, n, dtype, seed, max_value=10000):
+        if not self.available:
+            rng = random.Random(seed)
+            return array.array('i', (rng.randrange(max_value) for _ in range(n)))
+        buf = array.array('i', bytes(4 * n))
+        if hasattr(self.lib, "generate_data_ex"):
+            self.lib.generate_data_ex(self._as_c(buf), n, dtype, seed, 0, max_value)
+        else:  # 旧版 DLL
+            self.lib.generate_data_c(self._as_c(buf), n, min(dtype, 2))
+        return buf
+
+    BIN_MAGIC = b"SRTB"  # 与 sort_engine.h 中 SORT_BIN_MAGIC 的小端字节一致
+
+    @staticmethod
+    def _path(path):
+        return path.encode("mbcs" if os.name == "nt" else "utf-8")
+
+    def load_file(self, path):
+        """读取文本或二进制数据文件，返回 array('i')；DLL 不可用时退回纯 Python 解析"""
+        with open(path, 'rb') as f:
+            is_bin = f.read(4) == self.BIN_MAGIC
+        if not (self.available and hasattr(self.lib, "load_text_file")):
+            with open(path, 'rb') as f:
+                raw = f.read()
+            if is_bin: return array.array('i', raw[16:])
+            return array.array('i', (int(x) for x in re.findall(rb'-?[0-9]+', raw)))
+        ptr, n = ctypes.POINTER(ctypes.c_int)(), ctypes.c_int()
+        loader = self.lib.load_binary_file if is_bin else self.lib.load_text_file
+        if loader(self._path(path), 0, ctypes.byref(ptr), ctypes.byref(n)) != 0:
+            raise IOError(f"无法读取 {path}")
+        buf = array.array('i', bytes(4 * n.value))
+        if n.value: ctypes.memmove(self._as_c(buf), ptr, 4 * n.value)
+        if is_bin:
+            self.lib.unmap_binary_file(ptr)
+        else:
+            self.lib.sort_free(ptr)
+        return buf
+
+    def save_binary(self, path, data):
+        if self.available and hasattr(self.lib, "save_binary_file"):
+            buf = array.array('i', data)
+            if self.lib.save_binary_file(self._path(path), self._as_c(buf), len(buf)) != 0:
+                raise IOError(f"无法写入 {path}")
+            return
+        with open(path, 'wb') as f:
+            f.write(self.BIN_MAGIC + struct.pack('<IQ', 1, len(data)) + array.array('i', data).tobytes())
+
+    def sort_batch(self, data, offsets=None, seg_len=0, fast=True):
+        """一次调用排序 data (array('i')) 中的所有段：offsets 为各段起点加总长度，或每 seg_len 个元素一段"""
+        if not (self.available and hasattr(self.lib, "sort_batch")): return None
+        stats = SortPerformance()
+        opt = 1 if fast else 0  # SORT_OPT_FAST
+        if offsets is not None:
+            offs = array.array('i', offsets)
+            ret = self.lib.sort_batch(self._as_c(data), self._as_c(offs), len(offs) - 1, 0, opt, ctypes.byref(stats))
+        else:
+            ret = self.lib.sort_batch_fixed(self._as_c(data), len(data), seg_len, 0, opt, ctypes.byref(stats))
+        return stats if ret == 0 else None
+
+    def run_selections(self, data, k, chunk=65536):
+        """第 k 小、部分排序 (各在副本上) 与分块输入的流式 top-k，均为计数版，返回 [(名称, stats)]"""
+        if not (self.available and hasattr(self.lib, "nth_element")) or len(data) == 0: return []
+        k = max(1, min(k, len(data)))
+        src = data if isinstance(data, array.array) else array.array('i', data)
+        results = []
+        for label, func, kk in (("第k小", self.lib.nth_element, k - 1), ("部分排序", self.lib.partial_sort, k)):
+            work, stats = array.array('i', src), SortPerformance()
+            if func(self._as_c(work), len(work), kk, 0, ctypes.byref(stats)) == 0:
+                results.append((f"{label} (k={k})", stats))
+        stream = self.lib.topk_create(k, 0)
+        if stream:
+            base, stats = ctypes.addressof(self._as_c(src)), SortPerformance()
+            for i in range(0, len(src), chunk):
+                self.lib.topk_push(stream, base + 4 * i, min(chunk, len(src) - i))
+            out = array.array('i', bytes(4 * k))
+            if self.lib.topk_result(stream, self._as_c(out), ctypes.byref(stats)) >= 0:
+                results.append((f"流式Top-K (k={k})", stats))
+            self.lib.topk_destroy(stream)
+        return results
+
+    TRACE_MAX_EVENTS = 1 << 23  # 追踪缓冲上限 (每个事件 8 字节)
+    TRACE_QUADRATIC_MAX = 10000  # O(n²) 算法超过该规模时不追踪，排序本身就要数秒
+
+    @staticmethod
+    def _inversions(data):
+        """逆序对个数 (树状数组)：冒泡排序的交换次数、插入排序的移位次数都恰好等于它"""
+        rank = {v: i + 1 for i, v in enumerate(sorted(set(data)))}
+        tree = [0] * (len(rank) + 1)
+        inv = 0
+        for seen, v in enumerate(data):
+            k, le = rank[v], 0
+            while k:
+                le += tree[k]; k -= k & -k
+            inv += seen - le
+            k = rank[v]
+            while k < len(tree):
+                tree[k] += 1; k += k & -k
+        return inv
+
+    def trace(self, algo_name, data):
+        """在 C 端运行算法并记录操作，返回可按帧下标访问的 TraceHistory；没有追踪版的算法返回 None"""
+        if not (self.available and hasattr(self.lib, "sort_trace_run")): return None
+        algo = self.ALGO_NAMES.index(algo_name)
         n = len(data)
-        ArrayType = ctypes.c_int * n
-        c_arr = ArrayType(*data)
-        stats = func(c_arr, n)
-        return stats, list(c_arr)
+        opt = SortTraceOptions()
+        opt.capacity = self.TRACE_MAX_EVENTS
+        if algo <= 2:
+            # O(n²) 算法：交换/写入/归位必须完整记录，比较约 n²/2 次，按剩余缓冲抽样。
+            # 冒泡与插入的交换/写入随逆序对数增长 (随机输入约 n²/4)，放不下时不追踪，免得动画停在半途
+            if n > self.TRACE_QUADRATIC_MAX: return None
+            inv = self._inversions(data) if algo < 2 else 0
+            moves = inv + 2 * n if algo < 2 else 4 * n
+            spare = self.TRACE_MAX_EVENTS - moves
+            if spare < self.TRACE_MAX_EVENTS // 4: return None
+            compares = inv + n if algo == 1 else n * (n - 1) // 2
+            opt.compareSample = max(1, -(-compares // spare))
+        work = array.array('i', data)
+        stats = SortPerformance()
+        handle = self.lib.sort_trace_run(algo, self._as_c(work) if len(work) else None, len(work),
+                                         ctypes.byref(opt), ctypes.byref(stats))
+        if not handle: return None
+        return TraceHistory(self.lib, handle, len(work), stats)
+
+    def sorted_tree(self):
+        """新建 C 端在线有序容器；DLL 不可用或版本过旧时返回 None"""
+        if not (self.available and hasattr(self.lib, "sort_tree_create")): return None
+        return SortedTree(self.lib)
+
+    # 下标与 C 端 SortAlgorithm 一致
+    ALGO_NAMES = ["冒泡排序", "插入排序", "选择排序", "希尔排序", "快速排序", "归并排序", "堆排序",
+                  "并行归并", "并行快排", "基数排序", "模式快排", "自适应归并",
+                  "乒乓归并", "四路归并", "计数排序", "自适应"]
+
+    @staticmethod
+    def engine_suffix(stats):
+        """自适应排序实际使用的引擎，如 " (Radix Sort)"；其他算法为空串"""
+        name = stats.algorithm.decode("ascii", "ignore")
+        return f" ({name[6:]})" if name.startswith("Auto: ") else ""
+
+    def run_sort(self, algo_name, data, in_place=False):
+        """排序 data (array('i')、numpy int32 等缓冲)。in_place 时直接排序 data 本身，否则结果写入新的 array('i')"""
+        if not self.available: return None
+        algo = self.ALGO_NAMES.index(algo_name)
+        buf = self._buffer_of(data)
+        if buf is None:  # list 等非缓冲对象先整体转换一次
+            data = array.array('i', data)
+            buf = self._buffer_of(data)
+        if hasattr(self.lib, "sort_buffer"):
+            ctx = SortContext()
+            ctx.options = SORT_OPT_NO_COPY if in_place else 0
+            work = data if in_place else array.array('i', bytes(4 * buf.length))
+            out = None if in_place else ctypes.addressof(self._as_c(work))
+            if self.lib.sort_buffer(ctypes.byref(ctx), algo, ctypes.byref(buf), out) != 0: return None
+            return ctx.stats, work
+        # 旧版 DLL：按名称调用各算法的导出函数
+        name = ["bubble_sort", "insertion_sort", "selection_sort", "shell_sort", "quick_sort", "merge_sort",
+                "heap_sort", "parallel_merge_sort", "parallel_quick_sort", "radix_sort", "pdq_sort", "tim_sort",
+                "pingpong_merge_sort", "pingpong_merge_sort4", "counting_sort", "auto_sort"][algo]
+        if not hasattr(self.lib, name): return None
+        func = getattr(self.lib, name)
+        work = data if in_place else array.array('i', data)
+        c_arr = self._as_c(work)
+        stats = func(c_arr, len(work), 0) if name.startswith("parallel") else func(c_arr, len(work))
+        return stats, work
+
+
+class SortedTree:
+    """C 端 B+ 树 (sort_btree.c) 的封装：增量插入/删除，随时按名次或值域取有序数据"""
+
+    def __init__(self, lib):
+        self.lib = lib
+        self.handle = lib.sort_tree_create()
+        if not self.handle: raise MemoryError("sort_tree_create 失败")
+
+    def __del__(self):
+        if getattr(self, "handle", None):
+            self.lib.sort_tree_destroy(self.handle)
+            self.handle = None
+
+    def __len__(self):
+        return self.lib.sort_tree_size(self.handle)
+
+    def add(self, value):
+        if self.lib.sort_tree_insert(self.handle, value) != 0: raise MemoryError
+
+    def update(self, values):
+        buf = values if isinstance(values, array.array) and values.typecode == 'i' else array.array('i', values)
+        if len(buf) and self.lib.sort_tree_insert_bulk(self.handle, C_Backend._as_c(buf), len(buf)) != 0:
+            raise MemoryError
+
+    def remove(self, value):
+        """删除一个等于 value 的元素，返回是否存在"""
+        return self.lib.sort_tree_erase(self.handle, value) == 1
+
+    def rank(self, value):
+        return self.lib.sort_tree_rank(self.handle, value)
+
+    def __getitem__(self, index):
+        if index < 0: index += len(self)
+        out = ctypes.c_int()
+        if self.lib.sort_tree_select(self.handle, index, ctypes.byref(out)) != 0: raise IndexError(index)
+        return out.value
+
+    def slice(self, start, count):
+        """名次 [start, start + count) 的有序元素"""
+        out = array.array('i', bytes(4 * max(0, min(count, len(self) - start))))
+        if len(out): self.lib.sort_tree_copy(self.handle, start, C_Backend._as_c(out), len(out))
+        return out
+
+    def range(self, lo, hi):
+        """值在 [lo, hi] 内的有序元素"""
+        return self.slice(self.rank(lo), self.lib.sort_tree_range(self.handle, lo, hi, None, 0))
 
 
 # 2. 逻辑层：快照生成器
@@ -90,6 +453,74 @@ class Snapshot:
         self.text = text;
         self.sorted_idxs = set(sorted_idxs)
 
+    def column_color(self, a, b):
+        """下标 [a, b) 合并成一根柱子时的颜色"""
+        for i in range(a, b):
+            if i in self.colors: return self.colors[i]
+        return COLOR_KEYS["default"]
+
+
+class TraceFrame:
+    """C 端回放出的一帧：只记录本步高亮的下标，已归位的位置按 marks 着色"""
+
+    def __init__(self, data, colors, text, marks):
+        self.data = data;
+        self.colors = colors;
+        self.text = text;
+        self.marks = marks
+
+    def column_color(self, a, b):
+        for i, color in self.colors.items():
+            if a <= i < b: return color
+        return COLOR_KEYS["sorted"] if all(self.marks[a:b]) else COLOR_KEYS["default"]
+
+
+class TraceHistory:
+    """C 端操作追踪 (sort_trace.c) 的惰性历史：第 k 帧在访问时从最近的关键帧回放出来"""
+
+    def __init__(self, lib, handle, n, stats):
+        self.lib = lib
+        self.handle = handle
+        self.n = n
+        self.stats = stats
+        self.first = lib.sort_trace_first(handle)
+        self.length = lib.sort_trace_length(handle)
+        self.truncated = lib.sort_trace_truncated(handle) != 0
+
+    def __del__(self):
+        if getattr(self, "handle", None):
+            self.lib.sort_trace_free(self.handle)
+            self.handle = None
+
+    def __len__(self):
+        return self.length - self.first + 1
+
+    def __getitem__(self, index):
+        if index < 0: index += len(self)
+        step = self.first + index
+        data = array.array('i', bytes(4 * self.n))
+        marks = ctypes.create_string_buffer(max(self.n, 1))
+        if self.lib.sort_trace_frame(self.handle, step, C_Backend._as_c(data) if self.n else None, marks) != 0:
+            raise IndexError(index)
+        marks = marks.raw[:self.n]
+        if step == self.length:
+            if not self.truncated: marks = b"\x01" * self.n
+            text = "追踪缓冲已满，之后的步骤未记录" if self.truncated else "排序完成"
+            return TraceFrame(data, {}, text, marks)
+        if step == 0: return TraceFrame(data, {}, "初始状态", marks)
+        ev = SortEvent()
+        self.lib.sort_trace_event(self.handle, step - 1, ctypes.byref(ev))
+        kind, i, j = ev.head >> 28, ev.head & 0x0fffffff, ev.arg
+        if kind == SORT_EV_COMPARE:
+            colors, text = {i: COLOR_KEYS["compare"], j: COLOR_KEYS["compare"]}, f"比较: {data[i]} 与 {data[j]}"
+        elif kind == SORT_EV_SWAP:
+            colors, text = {i: COLOR_KEYS["active"], j: COLOR_KEYS["active"]}, f"交换: {data[j]} 与 {data[i]}"
+        elif kind == SORT_EV_WRITE:
+            colors, text = {i: COLOR_KEYS["active"]}, f"写入 {j} 到索引 {i}"
+        else:
+            colors, text = {i: COLOR_KEYS["sorted"]}, f"索引 {i} 归位: {data[i]}"
+        return TraceFrame(data, colors, text, marks)
+
 
 class SortLogic:
     def generate_history(self, algo_name, original_data):
@@ -255,6 +686,28 @@ class SortLogic:
                 heapify(i, 0)
             sorted_indices.add(0)
 
+        elif algo_name == "基数排序":
+            # 与 C 端一致：按字节分桶，最高字节翻转符号位，单桶的趟跳过
+            def digit(v, p):
+                d = ((v & 0xFFFFFFFF) >> (8 * p)) & 0xFF
+                return d ^ 0x80 if p == 3 else d
+
+            for p in range(4):
+                buckets = [[] for _ in range(256)]
+                for i, v in enumerate(data):
+                    add_frame({i: COLOR_KEYS["compare"]}, f"第 {p + 1} 趟: {v} 的第 {p} 字节为 {digit(v, p)}")
+                    buckets[digit(v, p)].append(v)
+                if n == 0 or any(len(b) == n for b in buckets):
+                    add_frame({}, f"第 {p + 1} 趟所有元素同桶，跳过")
+                    continue
+                k = 0
+                for b in buckets:
+                    for v in b:
+                        data[k] = v
+                        add_frame({k: COLOR_KEYS["active"]}, f"第 {p + 1} 趟回写 {v}")
+                        k += 1
+            sorted_indices.update(range(n))
+
         else:
             sorted_indices.update(range(n));
             add_frame({}, "可视化逻辑使用默认")
@@ -288,6 +741,7 @@ class VisualSortApp:
         self.is_playing = False;
         self.comparison_results = [];
         self.current_data_type = "随机"
+        self.current_seed = 0
         self._setup_ui();
         self.generate_data(0)
 
@@ -303,6 +757,7 @@ class VisualSortApp:
 
         btn_cfg = {"bg": "#444", "fg": "white", "relief": "flat", "font": ("微软雅黑", 9)}
         tk.Button(top, text="📂 导入数据", command=self.import_data, **btn_cfg).pack(side=tk.LEFT, padx=10)
+        tk.Button(top, text="💾 导出二进制", command=self.export_binary, **btn_cfg).pack(side=tk.LEFT, padx=5)
         tk.Button(top, text="📊 全算法对比", command=self.run_comparison_all, bg="#e0aa00", fg="black").pack(
             side=tk.LEFT, padx=5)
         self.lbl_perf = tk.Label(top, text="C引擎: 就绪", bg="#1e1e1e", fg="#00ffcc", font=("Consolas", 10))
@@ -355,12 +810,20 @@ class VisualSortApp:
             side=tk.LEFT, padx=2)
         tk.Button(left_box, text="逆序", command=lambda: self.generate_data(2), bg="#555", fg="white", width=5).pack(
             side=tk.LEFT, padx=2)
+        self.dist_var = tk.StringVar(value="更多分布")
+        dist_cb = ttk.Combobox(left_box, textvariable=self.dist_var, values=DIST_NAMES[3:], state="readonly", width=8)
+        dist_cb.pack(side=tk.LEFT, padx=2)
+        dist_cb.bind("<<ComboboxSelected>>", lambda e: self.generate_data(DIST_NAMES.index(self.dist_var.get())))
+        tk.Label(left_box, text=" 种子:", bg="#333", fg="white").pack(side=tk.LEFT)
+        self.seed_var = tk.StringVar(value="")  # 留空则每次随机取种子
+        tk.Entry(left_box, textvariable=self.seed_var, width=8).pack(side=tk.LEFT)
         tk.Label(left_box, text="  数据量:", bg="#333", fg="white").pack(side=tk.LEFT)
-        self.lbl_n_val = tk.Label(left_box, text="50", bg="#333", fg="cyan", width=3);
+        self.lbl_n_val = tk.Label(left_box, text="50", bg="#333", fg="cyan", width=6);
         self.lbl_n_val.pack(side=tk.LEFT)
-        self.scale_n = tk.Scale(left_box, from_=10, to=300, orient=tk.HORIZONTAL, bg="#333", fg="white", showvalue=0,
-                                command=self.on_scale_n);
-        self.scale_n.set(50);
+        # 对数刻度：0 ~ 100 对应 10 ~ 100000 个元素
+        self.scale_n = tk.Scale(left_box, from_=0, to=100, resolution=0.5, orient=tk.HORIZONTAL, bg="#333", fg="white",
+                                showvalue=0, command=self.on_scale_n);
+        self.scale_n.set(17.5);
         self.scale_n.pack(side=tk.LEFT)
 
         right_box = tk.Frame(ctrl, bg="#333");
@@ -390,8 +853,11 @@ class VisualSortApp:
         lbl.pack(anchor="w", padx=15)
         return lbl
 
+    def data_size(self):
+        return int(round(10 ** (1 + self.scale_n.get() / 25)))
+
     def on_scale_n(self, val):
-        self.lbl_n_val.config(text=str(val)); self.generate_data(0)
+        self.lbl_n_val.config(text=str(self.data_size())); self.generate_data(0)
 
     def on_scale_spd(self, val):
         self.lbl_spd_val.config(text=f"{val}ms")
@@ -414,15 +880,15 @@ class VisualSortApp:
         frame.pack(fill=tk.BOTH, expand=True, padx=10, pady=10)
 
         # 增加列：综合评分、性能评价
-        cols = ("算法", "耗时(ms)", "比较次数", "移动次数", "综合评分", "性能评价")
+        cols = ("算法", "耗时(ms)", "比较次数", "移动次数", "趟数", "综合评分", "性能评价")
         tree = ttk.Treeview(frame, columns=cols, show="headings")
         for col in cols: tree.heading(col, text=col, anchor="center"); tree.column(col, anchor="center", width=120)
         tree.pack(side=tk.LEFT, fill=tk.BOTH, expand=True)
 
-        results = []
-        for algo_name in ALGO_INFO.keys():
-            res = self.backend.run_sort(algo_name, self.data)
-            if res: results.append((algo_name, res[0]))
+        # C 引擎可重入，各算法并行运行 (ctypes 调用期间会释放 GIL)
+        with ThreadPoolExecutor(max_workers=os.cpu_count() or 1) as pool:
+            runs = list(pool.map(lambda name: (name, self.backend.run_sort(name, self.data)), ALGO_INFO.keys()))
+        results = [(algo_name, res[0]) for algo_name, res in runs if res]
 
         if results:
             min_time = min(r[1].timeCost for r in results)
@@ -436,12 +902,25 @@ class VisualSortApp:
                 # 记录详细结果用于导出
                 self.comparison_results.append({
                     "algo": algo_name, "time": stats.timeCost, "comp": stats.compareCount,
-                    "move": stats.moveCount, "score": score, "eval": eval_str
+                    "move": stats.moveCount, "passes": stats.passes, "score": score, "eval": eval_str
                 })
 
                 tree.insert("", tk.END, values=(
-                    algo_name, f"{stats.timeCost:.6f}", stats.compareCount, stats.moveCount,
-                    f"{score:.1f}", eval_str
+                    algo_name + C_Backend.engine_suffix(stats), f"{stats.timeCost:.6f}", stats.compareCount,
+                    stats.moveCount, stats.passes, f"{score:.1f}", eval_str
+                ))
+
+            # 只取前 1% 时的选择算法：不参与评分，比较次数对照模式快排的全排序
+            base = next((s for name, s in results if name == "模式快排"), None)
+            for algo_name, stats in self.backend.run_selections(self.data, len(self.data) // 100):
+                ratio = stats.compareCount / base.compareCount if base and base.compareCount else 0
+                eval_str = f"比较为全排序的 {ratio:.1%}" if base else "-"
+                self.comparison_results.append({
+                    "algo": algo_name, "time": stats.timeCost, "comp": stats.compareCount,
+                    "move": stats.moveCount, "passes": stats.passes, "score": None, "eval": eval_str
+                })
+                tree.insert("", tk.END, values=(
+                    algo_name, f"{stats.timeCost:.6f}", stats.compareCount, stats.moveCount, stats.passes, "-", eval_str
                 ))
 
         tk.Button(top, text="导出此表格", command=self.export_report, height=2, bg="#e0aa00").pack(pady=10, fill=tk.X,
@@ -455,12 +934,12 @@ class VisualSortApp:
             with open(path, 'w', newline='', encoding='utf-8-sig') as f:
                 writer = csv.writer(f)
                 writer.writerow(
-                    ["时间", "数据类型", "算法", "数据量", "耗时(ms)", "比较次数", "移动次数", "综合评分", "性能评价"])
+                    ["时间", "数据类型", "算法", "数据量", "耗时(ms)", "比较次数", "移动次数", "趟数", "综合评分", "性能评价"])
                 now = datetime.datetime.now().strftime("%Y-%m-%d %H:%M:%S")
                 for item in self.comparison_results:
                     writer.writerow([
                         now, self.current_data_type, item["algo"], len(self.data),
-                        f"{item['time']:.6f}", item["comp"], item["move"], f"{item['score']:.1f}", item["eval"]
+                        f"{item['time']:.6f}", item["comp"], item["move"], item["passes"], f"{item['score']:.1f}" if item["score"] is not None else "-", item["eval"]
                     ])
             messagebox.showinfo("成功", "已导出")
         except Exception as e:
@@ -468,10 +947,11 @@ class VisualSortApp:
 
     def run_benchmark(self):
         if not self.backend.available: return
-        res = self.backend.run_sort(self.algo_var.get(), self.data)
+        res = self.backend.run_sort(self.algo_var.get(), self.data, in_place=True)  # 结果替换 self.data，无需副本
         if not res: return
         stats, sorted_data = res
-        self.lbl_perf.config(text=f"C测速: {stats.timeCost:.6f}ms | 比较 {stats.compareCount} | 移动 {stats.moveCount}")
+        self.lbl_perf.config(text=f"C测速{C_Backend.engine_suffix(stats)}: {stats.timeCost:.6f}ms | "
+                                  f"比较 {stats.compareCount} | 移动 {stats.moveCount}")
         self.data = sorted_data;
         self.prepare_anim()
         self.current_step = len(self.history) - 1;
@@ -481,25 +961,40 @@ class VisualSortApp:
         path = filedialog.askopenfilename()
         if not path: return
         try:
-            with open(path, 'r') as f:
-                nums = [int(x) for x in f.read().replace(',', ' ').split() if x.strip().isdigit()]
-                if nums: self.data = nums; self.current_data_type = "导入"; self.lbl_n_val.config(
-                    text=str(len(nums))); self.prepare_anim()
+            nums = self.backend.load_file(path)
+            if nums: self.data = nums; self.current_data_type = "导入"; self.lbl_n_val.config(
+                text=str(len(nums))); self.prepare_anim()
+        except Exception as e:
+            messagebox.showerror("错误", str(e))
+
+    def export_binary(self):
+        if not self.data: return
+        path = filedialog.asksaveasfilename(defaultextension=".bin", filetypes=[("二进制数组", "*.bin")])
+        if not path: return
+        try:
+            self.backend.save_binary(path, self.data)
         except Exception as e:
             messagebox.showerror("错误", str(e))
 
     def generate_data(self, type_code):
-        self.current_data_type = ["随机", "正序", "逆序"][type_code]
-        if self.backend.available:
-            self.data = self.backend.generate_data(self.scale_n.get(), type_code)
-        else:
-            self.data = [random.randint(0, 800) for _ in range(self.scale_n.get())]
+        text = self.seed_var.get().strip()
+        self.current_seed = int(text) if text.isdigit() else random.getrandbits(32)
+        self.current_data_type = f"{DIST_NAMES[type_code]} (种子 {self.current_seed})"
+        self.data = self.backend.generate_data(self.data_size(), type_code, self.current_seed)
         self.prepare_anim()
 
+    PY_HISTORY_MAX = 300  # Python 模拟历史的规模上限
+
     def prepare_anim(self):
         self.is_playing = False;
         self.btn_play.config(text="▶")
-        self.history = self.logic.generate_history(self.algo_var.get(), self.data)
+        # 经典算法由 C 端记录真实执行过程；其余算法小规模时用 Python 模拟，大规模只显示首尾
+        self.history = self.backend.trace(self.algo_var.get(), self.data)
+        if self.history is None and len(self.data) > self.PY_HISTORY_MAX:
+            self.history = [Snapshot(self.data, {}, "初始状态", []),
+                            Snapshot(sorted(self.data), {}, "排序完成 (该算法没有逐步追踪)", [])]
+        elif self.history is None:
+            self.history = self.logic.generate_history(self.algo_var.get(), self.data)
         self.current_step = 0;
         self.progress['maximum'] = len(self.history) - 1;
         self.progress['value'] = 0;
@@ -514,13 +1009,17 @@ class VisualSortApp:
         self.progress['value'] = self.current_step
         w = self.canvas.winfo_width();
         h = self.canvas.winfo_height()
+        # 元素多于像素列时按列合并，每列画区间内的最大值
         n = len(snap.data);
-        bar_w = w / max(n, 1);
-        max_val = max(snap.data) if snap.data else 1
-        for i, val in enumerate(snap.data):
-            x0 = i * bar_w;
+        cols = max(min(n, w), 1);
+        bar_w = w / cols;
+        max_val = max(max(snap.data), 1) if n else 1
+        for c in range(min(n, cols)):
+            a, b = c * n // cols, (c + 1) * n // cols
+            val = snap.data[a] if b - a == 1 else max(snap.data[a:b])
+            x0 = c * bar_w;
             y0 = h - (val / max_val * (h - 20))
-            self.canvas.create_rectangle(x0, y0, x0 + bar_w - 1, h, fill=snap.colors.get(i, COLOR_KEYS["default"]),
+            self.canvas.create_rectangle(x0, y0, x0 + max(bar_w - 1, 1), h, fill=snap.column_color(a, b),
                                          outline="")
 
     def toggle(self):
@@ -529,7 +1028,8 @@ class VisualSortApp:
 
     def run_anim(self):
         if self.is_playing and self.current_step < len(self.history) - 1:
-            self.current_step += 1;
+            # 步数很多时每帧前进若干步，整段播放约 2000 帧
+            self.current_step = min(self.current_step + max(1, len(self.history) // 2000), len(self.history) - 1);
             self.draw_frame();
             self.root.after(self.scale_spd.get(), self.run_anim)
         else: